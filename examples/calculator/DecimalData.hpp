@@ -1,9 +1,11 @@
 #pragma once
 
 #include <nodes/NodeDataModel>
+#include <nodes/TypedNodeDataModel>
 
 using QtNodes::NodeDataType;
 using QtNodes::NodeData;
+using QtNodes::TypeHandle;
 
 /// The class can potentially incapsulate any user data which
 /// need to be transferred within the Node Editor graph
@@ -19,12 +21,18 @@ public:
     : _number(number)
   {}
 
-  NodeDataType type() const override
+  static NodeDataType staticType()
   {
     return NodeDataType {"decimal",
                          "Decimal"};
   }
 
+  NodeDataType type() const override
+  { return staticType(); }
+
+  TypeHandle typeHandle() const override
+  { return QtNodes::staticTypeHandle<DecimalData>(); }
+
   double number() const
   { return _number; }
 
@@ -2,52 +2,29 @@
 
 #include "DecimalData.hpp"
 
-unsigned int
+std::shared_ptr<DecimalData>
 MathOperationDataModel::
-nPorts(PortType portType) const
+typedOutData(OutPort<0>)
 {
-  unsigned int result;
-
-  if (portType == PortType::In)
-    result = 2;
-  else
-    result = 1;
-
-  return result;
+  return _result;
 }
 
 
-NodeDataType
+void
 MathOperationDataModel::
-dataType(PortType, PortIndex) const
+setTypedInData(std::shared_ptr<DecimalData> data, InPort<0>)
 {
-  return DecimalData().type();
-}
-
+  _number1 = data;
 
-std::shared_ptr<NodeData>
-MathOperationDataModel::
-outData(PortIndex)
-{
-  return std::static_pointer_cast<NodeData>(_result);
+  compute();
 }
 
 
 void
 MathOperationDataModel::
-setInData(std::shared_ptr<NodeData> data, PortIndex portIndex)
+setTypedInData(std::shared_ptr<DecimalData> data, InPort<1>)
 {
-  auto numberData =
-    std::dynamic_pointer_cast<DecimalData>(data);
-
-  if (portIndex == 0)
-  {
-    _number1 = numberData;
-  }
-  else
-  {
-    _number2 = numberData;
-  }
+  _number2 = data;
 
   compute();
 }
@@ -4,11 +4,11 @@
 #include <QtCore/QJsonObject>
 #include <QtWidgets/QLabel>
 
-#include <nodes/NodeDataModel>
+#include <nodes/TypedNodeDataModel>
 
 #include <iostream>
 
-class DecimalData;
+#include "DecimalData.hpp"
 
 using QtNodes::PortType;
 using QtNodes::PortIndex;
@@ -16,10 +16,17 @@ using QtNodes::NodeData;
 using QtNodes::NodeDataType;
 using QtNodes::NodeDataModel;
 using QtNodes::NodeValidationState;
+using QtNodes::TypedNodeDataModel;
+using QtNodes::Inputs;
+using QtNodes::Outputs;
+using QtNodes::InPort;
+using QtNodes::OutPort;
 
 /// The model dictates the number of inputs and outputs for the Node.
 /// In this example it has no logic.
-class MathOperationDataModel : public NodeDataModel
+class MathOperationDataModel
+  : public TypedNodeDataModel<Inputs<DecimalData, DecimalData>,
+                              Outputs<DecimalData>>
 {
   Q_OBJECT
 
@@ -30,18 +37,14 @@ public:
 
 public:
 
-  unsigned int
-  nPorts(PortType portType) const override;
+  std::shared_ptr<DecimalData>
+  typedOutData(OutPort<0>) override;
 
-  NodeDataType
-  dataType(PortType portType,
-           PortIndex portIndex) const override;
-
-  std::shared_ptr<NodeData>
-  outData(PortIndex port) override;
+  void
+  setTypedInData(std::shared_ptr<DecimalData> data, InPort<0>) override;
 
   void
-  setInData(std::shared_ptr<NodeData> data, PortIndex portIndex) override;
+  setTypedInData(std::shared_ptr<DecimalData> data, InPort<1>) override;
 
   QWidget *
   embeddedWidget() override { return nullptr; }
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "NodeDataModel.hpp"
+#include "ComputeScheduler.hpp"
+#include "Export.hpp"
+
+namespace QtNodes
+{
+
+/**
+ * @brief The CancellationToken class tells a running computation that its
+ * result is no longer wanted. Copies share their state.
+ */
+class CancellationToken
+{
+public:
+
+  CancellationToken()
+    : _cancelled(std::make_shared<std::atomic<bool>>(false))
+  {}
+
+  bool
+  isCancelled() const
+  {
+    return _cancelled->load(std::memory_order_relaxed);
+  }
+
+  void
+  cancel()
+  {
+    _cancelled->store(true, std::memory_order_relaxed);
+  }
+
+private:
+
+  std::shared_ptr<std::atomic<bool>> _cancelled;
+};
+
+
+/**
+ * @brief The AsyncNodeDataModel class computes its outputs on worker threads.
+ * Derived models implement compute(), which receives a copy of the inputs.
+ * New inputs cancel the running computation and start another one; results
+ * are delivered on the model's thread and only those computed from the
+ * latest inputs reach dataUpdated().
+ *
+ * Jobs run on the ComputeScheduler of the model's scene, which caps how many
+ * of them run at once.
+ *
+ * Jobs use the derived model, so they must be stopped before it is
+ * destroyed. Node does so; a model owned elsewhere calls cancelAndWait()
+ * from its own destructor.
+ */
+class NODE_EDITOR_PUBLIC AsyncNodeDataModel
+  : public NodeDataModel
+{
+  Q_OBJECT
+
+public:
+
+  using Inputs  = std::vector<std::shared_ptr<NodeData>>;
+  using Outputs = std::vector<std::shared_ptr<NodeData>>;
+
+public:
+
+  AsyncNodeDataModel();
+
+  ~AsyncNodeDataModel() override;
+
+  /// Cancels the computation, waits for running ones to return and keeps
+  /// queued ones from starting. The model computes nothing afterwards.
+  void
+  cancelAndWait();
+
+  void
+  setInData(std::shared_ptr<NodeData> nodeData,
+            PortIndex port) final;
+
+  std::shared_ptr<NodeData>
+  outData(PortIndex port) final;
+
+  NodeProcessingStatus
+  processingStatus() const override;
+
+  /// Runs the jobs on the given scheduler, or on the default one if null
+  void
+  setScheduler(std::shared_ptr<ComputeScheduler> scheduler);
+
+  /// Number of computations started; results of older ones are discarded
+  quint64
+  generation() const
+  {
+    return _generation;
+  }
+
+protected:
+
+  /**
+   * @brief Computes the outputs, one per output port, on a worker thread.
+   * It may run concurrently with the model's thread and with computations of
+   * older inputs, so it must only read model state that doesn't change while
+   * it runs. It should return early once `token` is cancelled.
+   */
+  virtual
+  Outputs
+  compute(Inputs inputs, CancellationToken token) const = 0;
+
+  /// Whether the inputs allow computing; if not, outputs are reset without
+  /// computing. By default every input must be set.
+  virtual
+  bool
+  canCompute(Inputs const& inputs) const;
+
+  /// Starts computing again from the current inputs, e.g. after a parameter
+  /// of the model changed
+  void
+  recompute();
+
+private:
+
+  void
+  onComputeStarted(quint64 generation);
+
+  void
+  onComputeFinished(quint64 generation, Outputs outputs, bool failed);
+
+  void
+  setStatus(NodeProcessingStatus status);
+
+  void
+  emitOutputs();
+
+private:
+
+  struct Lifetime;
+
+  std::shared_ptr<Lifetime> _lifetime;
+
+  std::shared_ptr<ComputeScheduler> _scheduler;
+
+  Inputs _inputs;
+
+  Outputs _outputs;
+
+  CancellationToken _token;
+
+  quint64 _generation = 0;
+
+  NodeProcessingStatus _status = NodeProcessingStatus::NoStatus;
+};
+}
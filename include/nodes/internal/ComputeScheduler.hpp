@@ -0,0 +1,65 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#include "Export.hpp"
+
+namespace QtNodes
+{
+
+/**
+ * @brief The ComputeScheduler class runs the jobs of asynchronous models
+ * (see AsyncNodeDataModel) on worker threads, at most maxConcurrentJobs() at
+ * a time; further jobs wait in a queue. Each FlowScene has its own, so that a
+ * busy scene doesn't starve the others.
+ */
+class NODE_EDITOR_PUBLIC ComputeScheduler
+{
+public:
+
+  using Job = std::function<void()>;
+
+  explicit
+  ComputeScheduler(int maxConcurrentJobs = QThread::idealThreadCount());
+
+  /// Waits for the jobs that are queued or running
+  ~ComputeScheduler();
+
+  ComputeScheduler(ComputeScheduler const&) = delete;
+
+  ComputeScheduler&
+  operator=(ComputeScheduler const&) = delete;
+
+  int
+  maxConcurrentJobs() const;
+
+  void
+  setMaxConcurrentJobs(int count);
+
+  /// Queues a job, which runs on a worker thread
+  void
+  submit(Job job);
+
+  /// Number of jobs running on worker threads
+  int
+  activeJobs() const;
+
+  /// Waits for all the jobs, or until `msecs` elapsed unless it is negative;
+  /// returns false on timeout
+  bool
+  waitForDone(int msecs = -1);
+
+  /// Scheduler of the models that don't belong to a scene
+  static
+  std::shared_ptr<ComputeScheduler> const&
+  defaultScheduler();
+
+private:
+
+  QThreadPool _pool;
+};
+}
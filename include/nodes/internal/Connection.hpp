@@ -1,6 +1,10 @@
 #pragma once
 
-#include <QtCore/QObject>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include <QtCore/QUuid>
 #include <QtCore/QVariant>
 
@@ -11,7 +15,9 @@
 #include "ConnectionState.hpp"
 #include "ConnectionGeometry.hpp"
 #include "TypeConverter.hpp"
+#include "PropagationPolicy.hpp"
 #include "QUuidStdHash.hpp"
+#include "IdGenerator.hpp"
 #include "Export.hpp"
 #include "memory.hpp"
 
@@ -23,6 +29,30 @@ namespace QtNodes
 class Node;
 class NodeData;
 class ConnectionGraphicsObject;
+class Connection;
+
+/**
+ * @brief The ConnectionEvents struct holds the handlers a scene runs when any
+ * of its connections changes. It is shared by all the connections of the
+ * scene, so that connections don't need signals of their own.
+ */
+struct ConnectionEvents
+{
+  using Handler = std::function<void(Connection const&)>;
+
+  /// The connection got both of its ends attached.
+  std::vector<Handler> completed;
+
+  /// The connection lost one of its ends, or is being destroyed.
+  std::vector<Handler> madeIncomplete;
+
+  /// One of the ends of the connection was attached.
+  std::vector<Handler> updated;
+
+  /// A value held back by the connection's propagation policy waits for
+  /// flushPropagation().
+  std::vector<Handler> throttled;
+};
 
 /**
  * @brief The Connection class models a connection between ports of
@@ -30,12 +60,8 @@ class ConnectionGraphicsObject;
  * and an output node and port index.
  */
 class NODE_EDITOR_PUBLIC Connection
-  : public QObject
-  , public Serializable
+  : public Serializable
 {
-
-  Q_OBJECT
-
   friend class FlowScene;
 
 public:
@@ -66,9 +92,14 @@ public:
 
 public:
 
+  /// UUID of the connection, derived from its runtime id on first use.
   QUuid
   id() const;
 
+  /// Runtime identity of the connection, see IdGenerator.
+  ObjectId
+  objectId() const;
+
   /// Remembers the end being dragged.
   /// Invalidates Node address.
   /// Grabs mouse.
@@ -125,6 +156,10 @@ public:
   NodeDataType
   dataType(PortType portType) const;
 
+  /// Interned handle of dataType(), cached when a node is attached
+  TypeHandle
+  typeHandle(PortType portType) const;
+
   void
   setTypeConverter(TypeConverter converter);
 
@@ -133,23 +168,61 @@ public:
 
 public: // data propagation
 
+  /// Passes data on to the input node, as the propagation policy allows
   void
   propagateData(std::shared_ptr<NodeData> nodeData) const;
 
+  /// Resets the input right away, dropping any value held back
   void
   propagateEmptyData() const;
 
-Q_SIGNALS:
+  /// Current output of the output node, converted for the input port
+  std::shared_ptr<NodeData>
+  sourceData() const;
 
+  /// Defaults to the policy of the output port, see
+  /// NodeDataModel::portPropagationPolicy()
   void
-  connectionCompleted(Connection const&) const;
+  setPropagationPolicy(PropagationPolicy const& policy);
+
+  PropagationPolicy const&
+  propagationPolicy() const;
+
+  PropagationStats const&
+  propagationStats() const;
 
   void
-  connectionMadeIncomplete(Connection const&) const;
+  resetPropagationStats();
+
+  /// Delivers the value held back by the policy if it is due. Returns true
+  /// if a value still waits.
+  bool
+  flushPropagation() const;
 
 private:
 
-  QUuid _uid;
+  bool
+  deliveryDue() const;
+
+  void
+  deliver(std::shared_ptr<NodeData> nodeData) const;
+
+  /// Caches the type handle of the port the given end is attached to.
+  void
+  updateTypeHandle(PortType portType);
+
+  /// Runs the scene's handlers of the given event, if any.
+  void
+  notify(std::vector<ConnectionEvents::Handler> ConnectionEvents::* handlers) const;
+
+private:
+
+  ObjectId _objectId;
+
+  mutable QUuid _uid;
+
+  /// Set by the scene owning the connection.
+  std::weak_ptr<ConnectionEvents const> _events;
 
 private:
 
@@ -159,6 +232,9 @@ private:
   PortIndex _outPortIndex;
   PortIndex _inPortIndex;
 
+  TypeHandle _outTypeHandle = InvalidTypeHandle;
+  TypeHandle _inTypeHandle  = InvalidTypeHandle;
+
 private:
 
   ConnectionState    _connectionState;
@@ -168,9 +244,17 @@ private:
 
   TypeConverter _converter;
 
-Q_SIGNALS:
+private:
 
-  void
-  updated(Connection& conn) const;
+  PropagationPolicy _propagationPolicy;
+
+  mutable PropagationStats _propagationStats;
+
+  /// Latest value held back by a LatestValue policy
+  mutable std::shared_ptr<NodeData> _pendingData;
+
+  mutable bool _dataPending = false;
+
+  mutable std::chrono::steady_clock::time_point _lastDelivery;
 };
 }
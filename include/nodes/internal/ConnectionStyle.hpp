@@ -1,7 +1,11 @@
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include <QtGui/QColor>
 
+#include "DataTypeRegistry.hpp"
 #include "Export.hpp"
 #include "Style.hpp"
 
@@ -33,6 +37,10 @@ public:
   QColor constructionColor() const;
   QColor normalColor() const;
   QColor normalColor(QString typeId) const;
+
+  /// Data-defined color of an interned type. The color is resolved once,
+  /// when the type is first looked up, and then served from a flat table.
+  QColor const& normalColor(TypeHandle typeHandle) const;
   QColor selectedColor() const;
   QColor selectedHaloColor() const;
   QColor hoveredColor() const;
@@ -46,6 +54,12 @@ public:
 
   bool useDataDefinedColors() const;
 
+private:
+
+  void resolveTypeColors(TypeHandle typeHandle) const;
+
+  static QColor generatedTypeColor(QString const& typeId);
+
 private:
 
   QColor ConstructionColor;
@@ -60,5 +74,11 @@ private:
   float PointDiameter;
 
   bool UseDataDefinedColors;
+
+  /// Explicit per-type colors read from the "DataTypeColors" style object.
+  std::unordered_map<TypeHandle, QColor> _typeColorOverrides;
+
+  /// Colors indexed by TypeHandle, grown lazily as new types are looked up.
+  mutable std::vector<QColor> _typeColors;
 };
 }
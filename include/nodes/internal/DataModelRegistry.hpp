@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <set>
@@ -8,9 +9,12 @@
 #include <utility>
 #include <vector>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QString>
 
 #include "NodeDataModel.hpp"
+#include "ModelDescriptor.hpp"
+#include "DataTypeRegistry.hpp"
 #include "TypeConverter.hpp"
 #include "Export.hpp"
 #include "memory.hpp"
@@ -44,10 +48,12 @@ public:
   using RegisteredModelCreatorsMap = std::unordered_map<QString, RegistryItemCreator>;
   using RegisteredModelsCategoryMap = std::unordered_map<QString, QString>;
   using CategoriesSet = std::set<QString>;
+  using RegisteredModelDescriptorsMap = std::unordered_map<QString, ModelDescriptor>;
 
-  using RegisteredTypeConvertersMap = std::map<TypeConverterId, TypeConverter>;
+  /// Converters keyed by the packed handles of their input and output types.
+  using RegisteredTypeConvertersMap = std::unordered_map<quint64, TypeConverter>;
 
-  DataModelRegistry()  = default;
+  DataModelRegistry();
   ~DataModelRegistry() = default;
 
   DataModelRegistry(DataModelRegistry const &) = delete;
@@ -62,15 +68,31 @@ public:
   void registerModel(RegistryItemCreator creator,
                      QString const &category = "Nodes")
   {
-    const QString name = computeName<ModelType>(HasStaticMethodName<ModelType>{}, creator);
-    if (!_registeredItemCreators.count(name))
-    {
-      _registeredItemCreators[name] = std::move(creator);
-      _categories.insert(category);
-      _registeredModelsCategory[name] = category;
-    }
+    registerModelType<ModelType>(HasStaticMethodDescriptor<ModelType>{},
+                                 std::move(creator),
+                                 category);
   }
 
+  /**
+   * @brief Registers a model from its static description. The creator is not
+   * called until a node of this model is created, so registering does not
+   * construct the model or anything it owns (widgets, resources...).
+   */
+  void registerModel(ModelDescriptor descriptor,
+                     RegistryItemCreator creator);
+
+  /**
+   * @brief Registers the models listed in a plugin manifest (see
+   * ModelPlugin.hpp). The plugin library is only loaded when one of its
+   * models is first created. Returns false if the manifest can't be read.
+   */
+  bool registerPlugin(QString const &manifestFile);
+
+  /// Same as above, with an already parsed manifest whose library path is
+  /// relative to `directory`
+  bool registerPlugin(QJsonObject const &manifest,
+                      QString const &directory);
+
   template<typename ModelType>
   void registerModel(QString const &category = "Nodes")
   {
@@ -101,7 +123,12 @@ public:
   void registerTypeConverter(TypeConverterId const & id,
                              TypeConverter typeConverter)
   {
-    _registeredTypeConverters[id] = std::move(typeConverter);
+    // interning both ends here also gives the types their handles (and
+    // per-type table slots) before anything is painted
+    _registeredTypeConverters[converterKey(id.first, id.second)] =
+      std::move(typeConverter);
+
+    setCompatible(id.first.handle(), id.second.handle());
   }
 
   std::unique_ptr<NodeDataModel>create(QString const &modelName);
@@ -112,9 +139,61 @@ public:
 
   CategoriesSet const &categories() const;
 
+  RegisteredModelDescriptorsMap const &registeredModelDescriptors() const;
+
+  /**
+   * @brief Returns a value that changes whenever a model is registered.
+   * Revisions are unique across registries, so views caching the list of
+   * models only need to compare this value to know whether it is current.
+   */
+  quint64 revision() const
+  {
+    return _revision;
+  }
+
+  /// Description the model was registered with, or nullptr if it has none
+  ModelDescriptor const *descriptor(QString const &modelName) const;
+
   TypeConverter getTypeConverter(NodeDataType const & d1,
                                  NodeDataType const & d2) const;
 
+  /**
+   * @brief Tells whether data of type `from` can be fed to a port of type
+   * `to`, either directly or through a registered converter. This is a
+   * binary search among the few converter targets of `from`, so it is cheap
+   * enough to be asked for every port while a connection is dragged.
+   */
+  bool compatible(TypeHandle from, TypeHandle to) const
+  {
+    if (from == to)
+      return from != InvalidTypeHandle;
+
+    if (from >= _converterTargets.size())
+      return false;
+
+    auto const & targets = _converterTargets[from];
+
+    return std::binary_search(targets.begin(), targets.end(), to);
+  }
+
+  bool compatible(NodeDataType const & from,
+                  NodeDataType const & to) const
+  {
+    return compatible(from.handle(), to.handle());
+  }
+
+private:
+
+  static quint64 nextRevision();
+
+  void setCompatible(TypeHandle from, TypeHandle to);
+
+  static quint64 converterKey(NodeDataType const & d1,
+                              NodeDataType const & d2)
+  {
+    return (static_cast<quint64>(d1.handle()) << 32) | d2.handle();
+  }
+
 private:
 
   RegisteredModelsCategoryMap _registeredModelsCategory;
@@ -125,8 +204,63 @@ private:
 
   RegisteredTypeConvertersMap _registeredTypeConverters;
 
+  RegisteredModelDescriptorsMap _registeredModelDescriptors;
+
+  quint64 _revision;
+
+  /// Sorted handles of the types each type has a converter to. Only types
+  /// with converters have entries beyond an empty one.
+  std::vector<std::vector<TypeHandle>> _converterTargets;
+
 private:
 
+  // If the registered ModelType class has the static member method
+  //
+  //      static ModelDescriptor Descriptor();
+  //
+  // register it through its descriptor, without instantiating it.
+
+  template <typename T, typename = void>
+  struct HasStaticMethodDescriptor
+    : std::false_type
+  {};
+
+  template <typename T>
+  struct HasStaticMethodDescriptor<T,
+         typename std::enable_if<std::is_same<decltype(T::Descriptor()), ModelDescriptor>::value>::type>
+       : std::true_type
+         {};
+
+  template <typename ModelType>
+  void
+  registerModelType(std::true_type,
+                    RegistryItemCreator creator,
+                    QString const &category)
+  {
+    ModelDescriptor descriptor = ModelType::Descriptor();
+
+    if (descriptor.category.isEmpty())
+      descriptor.category = category;
+
+    registerModel(std::move(descriptor), std::move(creator));
+  }
+
+  template <typename ModelType>
+  void
+  registerModelType(std::false_type,
+                    RegistryItemCreator creator,
+                    QString const &category)
+  {
+    const QString name = computeName<ModelType>(HasStaticMethodName<ModelType>{}, creator);
+    if (!_registeredItemCreators.count(name))
+    {
+      _registeredItemCreators[name] = std::move(creator);
+      _categories.insert(category);
+      _registeredModelsCategory[name] = category;
+      _revision = nextRevision();
+    }
+  }
+
   // If the registered ModelType class has the static member method
   //
   //      static Qstring Name();
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+#include "QStringStdHash.hpp"
+#include "Export.hpp"
+
+namespace QtNodes
+{
+
+/// Dense integer standing for an interned NodeDataType id.
+using TypeHandle = std::uint32_t;
+
+static constexpr TypeHandle InvalidTypeHandle = ~TypeHandle(0);
+
+/**
+ * @brief The DataTypeRegistry class interns NodeDataType ids into small,
+ * dense integer handles. Handles are process-wide and never reused, so they
+ * can be used to index flat per-type tables (e.g. connection colors).
+ */
+class NODE_EDITOR_PUBLIC DataTypeRegistry
+{
+public:
+
+  /**
+   * @brief Returns the handle associated with the given type id, interning
+   * the id if it has not been seen before.
+   */
+  static
+  TypeHandle
+  handle(QString const& typeId);
+
+  /**
+   * @brief Returns the type id the given handle was interned from, or an
+   * empty string for unknown handles.
+   */
+  static
+  QString
+  typeId(TypeHandle handle);
+
+  /**
+   * @brief Returns the number of interned type ids. Every valid handle is
+   * strictly smaller than this value.
+   */
+  static
+  std::size_t
+  size();
+
+private:
+
+  DataTypeRegistry() = default;
+
+  DataTypeRegistry(DataTypeRegistry const&) = delete;
+
+  DataTypeRegistry&
+  operator=(DataTypeRegistry const&) = delete;
+
+  static
+  DataTypeRegistry&
+  instance();
+
+private:
+
+  mutable QMutex _mutex;
+
+  std::unordered_map<QString, TypeHandle> _handles;
+
+  std::vector<QString> _typeIds;
+};
+}
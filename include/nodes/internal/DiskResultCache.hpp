@@ -0,0 +1,192 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QString>
+
+#include "NodeData.hpp"
+#include "QStringStdHash.hpp"
+#include "Export.hpp"
+
+namespace QtNodes
+{
+
+/**
+ * @brief The DiskResultCache class stores node outputs in a directory, so
+ * that they outlive the session that computed them. Entries are addressed by
+ * a digest of the model's saved state and of the content hashes of its
+ * inputs; nodes whose inputs have no content hash are not cached. Outputs are
+ * written through NodeData::serialize() and read back with the deserializer
+ * registered for their type.
+ *
+ * Nodes opt in with Node::setResultCache(). The least recently used entries
+ * are removed when the directory grows past its size limit.
+ */
+class NODE_EDITOR_PUBLIC DiskResultCache
+{
+public:
+
+  using Outputs = std::vector<std::shared_ptr<NodeData>>;
+
+  using Deserializer =
+    std::function<std::shared_ptr<NodeData>(QDataStream & stream)>;
+
+  struct Stats
+  {
+    quint64 hits = 0;
+
+    quint64 misses = 0;
+
+    quint64 writes = 0;
+
+    quint64 evictions = 0;
+
+    /// Outputs compared against their stored entry in verify mode
+    quint64 verified = 0;
+
+    /// Compared outputs that differed from their stored entry
+    quint64 verifyFailures = 0;
+
+    std::size_t entries = 0;
+
+    qint64 diskUsage = 0;
+  };
+
+  static constexpr qint64 DefaultMaxSize = 512 * 1024 * 1024;
+
+public:
+
+  /// Uses, and creates if needed, the given directory
+  explicit
+  DiskResultCache(QString const& directory,
+                  qint64 maxSize = DefaultMaxSize);
+
+  DiskResultCache(DiskResultCache const&) = delete;
+
+  DiskResultCache&
+  operator=(DiskResultCache const&) = delete;
+
+  QString
+  directory() const;
+
+  void
+  registerDeserializer(NodeDataType const& type,
+                       Deserializer deserializer);
+
+  /**
+   * @brief Builds the address of the outputs computed from the given model
+   * state and inputs, or returns an empty key if an input has no content
+   * hash, in which case the outputs can't be cached.
+   */
+  static
+  QByteArray
+  makeKey(QByteArray const& state,
+          std::vector<std::shared_ptr<NodeData>> const& inputs);
+
+  /// Reads the entry of the key; false on a miss or an unreadable entry
+  bool
+  load(QByteArray const& key, Outputs & outputs);
+
+  /// Writes an entry; false if an output can't be serialized
+  bool
+  store(QByteArray const& key, Outputs const& outputs);
+
+  /**
+   * @brief Compares freshly computed outputs with the stored entry of the
+   * key, and stores them if there is none. Returns false on a mismatch.
+   */
+  bool
+  verify(QByteArray const& key, Outputs const& outputs);
+
+  /// In verify mode nodes always compute and check their outputs against
+  /// the cache instead of loading them from it
+  bool
+  verifyMode() const
+  {
+    return _verifyMode;
+  }
+
+  void
+  setVerifyMode(bool verify)
+  {
+    _verifyMode = verify;
+  }
+
+  qint64
+  maxSize() const
+  {
+    return _maxSize;
+  }
+
+  /// Changing the limit evicts entries until it is honored
+  void
+  setMaxSize(qint64 bytes);
+
+  /// Removes every entry from the directory
+  void
+  clear();
+
+  Stats
+  stats() const;
+
+  /// Serializes outputs in the format of the cache entries; false if an
+  /// output can't be serialized
+  static
+  bool
+  encode(Outputs const& outputs, QByteArray & bytes);
+
+  /// Reads outputs written by encode() with the registered deserializers
+  bool
+  decode(QByteArray const& bytes, Outputs & outputs) const;
+
+private:
+
+  struct Entry
+  {
+    qint64 size;
+
+    /// Position in _useOrder
+    quint64 lastUse;
+  };
+
+  QString
+  filePath(QByteArray const& key) const;
+
+  void
+  touch(QByteArray const& key, qint64 size);
+
+  void
+  remove(QByteArray const& key);
+
+  void
+  evict(qint64 maxSize);
+
+private:
+
+  QDir _directory;
+
+  qint64 _maxSize;
+
+  bool _verifyMode = false;
+
+  std::unordered_map<QString, Deserializer> _deserializers;
+
+  std::map<QByteArray, Entry> _entries;
+
+  /// Keys by increasing time of last use
+  std::map<quint64, QByteArray> _useOrder;
+
+  quint64 _useCounter = 0;
+
+  qint64 _diskUsage = 0;
+
+  Stats _stats;
+};
+}
@@ -4,13 +4,16 @@
 #include <QtWidgets/QGraphicsScene>
 
 #include <unordered_map>
+#include <unordered_set>
 #include <tuple>
 #include <functional>
 
 #include "QUuidStdHash.hpp"
 #include "Export.hpp"
 #include "DataModelRegistry.hpp"
+#include "ComputeScheduler.hpp"
 #include "TypeConverter.hpp"
+#include "SceneChanges.hpp"
 #include "memory.hpp"
 
 #include "NodeGroup.hpp"
@@ -27,6 +30,7 @@ class ConnectionGraphicsObject;
 class NodeStyle;
 class NodeGroup;
 class GroupGraphicsObject;
+class SpatialGrid;
 
 /**
  * @brief The FlowScene class is responsible for handling nodes and
@@ -160,6 +164,12 @@ public:
 
   void setRegistry(std::shared_ptr<DataModelRegistry> registry);
 
+  /**
+   * @brief Returns the scheduler running the jobs of the scene's asynchronous
+   * models (see AsyncNodeDataModel), which caps how many of them run at once.
+   */
+  ComputeScheduler& computeScheduler() const;
+
   void iterateOverNodes(std::function<void(Node*)> const & visitor);
 
   void iterateOverNodeData(std::function<void(NodeDataModel*)> const & visitor);
@@ -172,6 +182,89 @@ public:
 
   QSizeF getNodeSize(Node const& node) const;
 
+public:
+
+  /**
+   * @brief Enables or disables the virtualized mode. When enabled, the graphics
+   * objects of nodes and connections lying outside the visible area of every
+   * attached view (plus a margin) are parked: they are detached from the
+   * QGraphicsScene, keeping their state, and attached again once they come
+   * back into view. Selected and grabbed items are never parked.
+   */
+  void setVirtualized(bool enabled);
+
+  bool isVirtualized() const;
+
+  /**
+   * @brief Schedules an update of the attached items. Views call this whenever
+   * their visible area changes; updates are coalesced until the next event loop
+   * iteration. Does nothing when the scene isn't virtualized, unless nodes are
+   * waiting to come into view to create their deferred widgets.
+   */
+  void scheduleVisibleAreaUpdate();
+
+  /**
+   * @brief Returns the bounding rect of all nodes, connections and groups,
+   * including the parked ones.
+   */
+  QRectF contentsBoundingRect() const;
+
+  /**
+   * @brief When enabled, the embedded widgets of nodes the user isn't interacting
+   * with are hidden and painted from a cached snapshot instead of through a live
+   * QGraphicsProxyWidget. The live widget is swapped in on hover or click, and
+   * swapped back out after a short period of inactivity.
+   */
+  void setWidgetSnapshotsEnabled(bool enabled);
+
+  bool widgetSnapshotsEnabled() const;
+
+  /**
+   * @brief Queues a move of the dragged nodes by the given offset. Offsets are
+   * accumulated and applied once per frame: all the nodes are moved in one
+   * batch, each affected connection is recomputed once and a single
+   * nodesMoved() signal is emitted.
+   */
+  void queueNodeDrag(QPointF const& offset);
+
+  /**
+   * @brief Applies the pending node drag right away, e.g. when the drag ends.
+   */
+  void flushNodeDrag();
+
+  /**
+   * @brief Records the move of the given node in the current change set, and
+   * emits nodeMoved() if fine-grained move signals are enabled.
+   */
+  void notifyNodeMoved(Node& node, QPointF const& newLocation);
+
+  /**
+   * @brief Records the moves of the given nodes in the current change set and
+   * emits nodesMoved().
+   */
+  void notifyNodesMoved(std::vector<Node*> const& nodes);
+
+  /**
+   * @brief Lets a virtualized scene account for a change in the size of the
+   * given node, and of its connections.
+   */
+  void notifyNodeResized(Node& node);
+
+  /**
+   * @brief Enables or disables the nodeMoved() signal, which is emitted for
+   * every single position change of every node. Disabled by default; observers
+   * should prefer changesCommitted() or nodesMoved().
+   */
+  void setNodeMovedSignalsEnabled(bool enabled);
+
+  bool nodeMovedSignalsEnabled() const;
+
+  /**
+   * @brief Emits changesCommitted() right away with the changes accumulated
+   * since the last change set, if any.
+   */
+  void flushChanges();
+
 public:
 
   std::unordered_map<QUuid, std::unique_ptr<Node> > const & nodes() const;
@@ -308,8 +401,27 @@ Q_SIGNALS:
 
   void connectionDeleted(Connection const &c);
 
+  /// A connection got both of its ends attached.
+  void connectionCompleted(Connection const &c);
+
+  /// A connection lost one of its ends, or is being destroyed.
+  void connectionMadeIncomplete(Connection const &c);
+
+  /// One of the ends of a connection was attached.
+  void connectionUpdated(Connection const &c);
+
+  /**
+   * @brief Node has been moved. Only emitted when enabled with
+   * setNodeMovedSignalsEnabled().
+   */
   void nodeMoved(Node& n, const QPointF& newLocation);
 
+  /**
+   * @brief Several nodes have been moved at once, e.g. by dragging their
+   * group. Emitted instead of nodeMoved() for each of them.
+   */
+  void nodesMoved(std::vector<Node*> const& nodes);
+
   void nodeDoubleClicked(Node& n);
 
   void nodeClicked(Node& n);
@@ -324,6 +436,12 @@ Q_SIGNALS:
 
   void nodeContextMenu(Node& n, const QPointF& pos);
 
+  /**
+   * @brief Nodes and connections have been created, deleted, moved or updated.
+   * Changes are collected and delivered at most once per frame.
+   */
+  void changesCommitted(QtNodes::SceneChanges const& changes);
+
 private:
 
   using SharedConnection = std::shared_ptr<Connection>;
@@ -336,13 +454,124 @@ private:
   // which is why it comes first in the class.
   std::shared_ptr<DataModelRegistry>          _registry{};
 
+  // Outlives the nodes too, whose asynchronous models queue jobs on it.
+  std::shared_ptr<ComputeScheduler>           _computeScheduler{
+    std::make_shared<ComputeScheduler>()};
+
   std::unordered_map<QUuid, SharedConnection> _connections{};
   std::unordered_map<QUuid, UniqueNode>       _nodes{};
   std::unordered_map<QUuid, SharedGroup>      _groups{};
 
+  /// Handlers shared by all the connections of the scene.
+  std::shared_ptr<ConnectionEvents>           _connectionEvents{};
+
+  bool _virtualized{false};
+  bool _visibleAreaUpdatePending{false};
+  bool _widgetSnapshotsEnabled{false};
+  bool _nodeDragPending{false};
+  bool _nodeMovedSignalsEnabled{false};
+  bool _changesPending{false};
+  bool _propagationPending{false};
+
+  SceneChangeAccumulator _changes{};
+
+  /// Interval, in ms, at which change sets are committed.
+  static constexpr int _changeSetInterval{16};
+
+  /// Connections holding back a value until the next propagation tick.
+  std::unordered_set<QUuid> _throttledConnections{};
+
+  /// Interval, in ms, at which held back values are delivered.
+  static constexpr int _propagationInterval{16};
+
+  /// Drag offset accumulated since the last applied frame.
+  QPointF _pendingDragOffset{};
+
+  /// Interval, in ms, at which queued node drags are applied.
+  static constexpr int _dragFrameInterval{16};
+
+  /**
+   * @brief _virtualizationMargin Extra area around each view, in view pixels, whose items are kept
+   * attached so that they're ready when scrolled into view.
+   */
+  static constexpr double _virtualizationMargin{256.0};
+
+  /// Graphics items of all the nodes, connections and groups, attached or not.
+  QList<QGraphicsItem*> allGraphicsItems() const;
+
+  /// Scene rects of the nodes and connections of a virtualized scene, so that
+  /// visibility passes only visit the items around the views.
+  std::unique_ptr<SpatialGrid> _spatialIndex;
+
+  /// Items whose rect in _spatialIndex is out of date.
+  std::unordered_set<QGraphicsItem*> _boundsDirtyItems{};
+
+  /// Items found visible by the last visibility pass.
+  std::unordered_set<QGraphicsItem*> _shownItems{};
+
+  /// Nodes whose deferred widget is created once a visibility pass finds them
+  /// in view. Visibility passes also run in non-virtualized scenes for them.
+  std::unordered_set<Node*> _nodesAwaitingWidget{};
+
+  /// Size, in scene units, of the cells of _spatialIndex.
+  static constexpr double _spatialCellSize{512.0};
+
+  /// Queues the rects of the node and its connections for a refresh.
+  void invalidateBounds(Node& node);
+
+  void invalidateBounds(QGraphicsItem* item);
+
+  /// Forgets an item about to be destroyed.
+  void dropBounds(QGraphicsItem* item);
+
+  /// Attaches or parks a single item, releasing what a parked node can rebuild.
+  void setItemAttached(QGraphicsItem* item, bool attached);
+
+  /// Has the item, if it's a node awaiting its deferred widget, create it.
+  void requestDeferredWidget(QGraphicsItem* item);
+
+  /// Stored node IDs mapped to the nodes restored from them. Restoring
+  /// connections through it neither materializes the UUIDs of the new nodes
+  /// nor looks them up in `_nodes`.
+  using NodeRemap = std::unordered_map<QUuid, Node*>;
+
+  /// The stored-to-new UUID map returned by the public load functions.
+  static std::unordered_map<QUuid, QUuid> publicIdMap(NodeRemap const& remap);
+
+  /// loadItems() returning the internal remap.
+  NodeRemap restoreItems(QByteArray const& data, QPointF pastePos, bool usePastePos);
+
+  /// restoreGroup() without freezing the restored nodes, which must wait
+  /// for the connections restored along with the group.
+  std::pair<std::weak_ptr<NodeGroup>, NodeRemap>
+      restoreGroupItems(QJsonObject const& groupJson);
+
+  /// Restores a connection between nodes of the given remap.
+  std::shared_ptr<Connection> restoreConnection(QJsonObject const& connectionJson,
+                                                NodeRemap const& remap);
+
+  /// Creates a stored connection between the given nodes.
+  std::shared_ptr<Connection> loadConnection(QJsonObject const& connectionJson,
+      Node& nodeIn,
+      Node& nodeOut,
+      std::unordered_map<QUuid, std::shared_ptr<Connection>>& connectionsMap);
+
+  /// Freezes the restored nodes that were saved frozen without their
+  /// pinned outputs, now that their inputs are connected.
+  void applyRestoredFreezes(NodeRemap const& remap);
+
 private Q_SLOTS:
 
-  void setupConnectionSignals(Connection const& c);
+  /// Attaches the items intersecting a view's visible area and parks the others.
+  void updateVisibleItems();
+
+  /// Commits the accumulated changes at the end of the frame.
+  void scheduleChanges();
+
+  /// Delivers the values held back by throttled connections on the next tick.
+  void schedulePropagation();
+
+  void flushPropagation();
 
   void sendConnectionCreatedToNodes(Connection const& c);
 
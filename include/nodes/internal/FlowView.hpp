@@ -1,11 +1,17 @@
 #pragma once
 
+#include <vector>
+
 #include <QtWidgets/QGraphicsView>
 
+#include "ModelPaletteIndex.hpp"
 #include "Export.hpp"
 
+class QLineEdit;
 class QMenu;
 class QMimeData;
+class QTreeWidget;
+class QTreeWidgetItem;
 
 namespace QtNodes
 {
@@ -215,6 +221,31 @@ protected:
 
   FlowScene * scene();
 
+private:
+
+  /**
+   * @brief Returns the cached pixmap of one coarse grid cell rendered for the
+   * given view scale and device pixel ratio.
+   */
+  static QPixmap gridTile(double scale, qreal dpr);
+
+  /**
+   * @brief Creates the model palette menu shown when the user right-clicks
+   * the scene background. It is kept for the lifetime of the view.
+   */
+  void createModelMenu();
+
+  /**
+   * @brief Rebuilds the model palette if the scene's registry changed since
+   * it was last built.
+   */
+  void updateModelPalette();
+
+  /**
+   * @brief Shows the palette models whose name contains the given text.
+   */
+  void filterModelPalette(QString const& text);
+
 private:
 
   QAction* _clearSelectionAction;
@@ -266,6 +297,37 @@ private:
 
   FlowScene* _scene;
 
+  /**
+   * @brief _lastVisibleArea Scene area shown the last time the background was drawn, used to tell
+   * a virtualized scene when the view was panned, zoomed or resized.
+   */
+  QRectF _lastVisibleArea{};
+
+  /**
+   * @brief _modelMenu, _modelFilter, _modelTree Model palette and its widgets, created on the first
+   * right-click on the scene background.
+   */
+  QMenu* _modelMenu{};
+  QLineEdit* _modelFilter{};
+  QTreeWidget* _modelTree{};
+
+  /**
+   * @brief _modelItems Palette items, in the order of the entries of _modelPaletteIndex.
+   */
+  std::vector<QTreeWidgetItem*> _modelItems;
+
+  ModelPaletteIndex _modelPaletteIndex;
+
+  /**
+   * @brief _modelPaletteRevision Registry revision the palette items were built for.
+   */
+  quint64 _modelPaletteRevision{};
+
+  /**
+   * @brief _modelMenuPos Scene position where a model picked from the palette is placed.
+   */
+  QPointF _modelMenuPos{};
+
   /**
    * @brief _clipboard A pointer to the application's clipboard.
    */
@@ -287,5 +349,18 @@ private:
    * times in a row.
    */
   static constexpr int _pastePosOffset{20};
+
+  /**
+   * @brief _fineGridStep, _coarseGridStep Spacing of the background grid lines, in scene units.
+   */
+  static constexpr double _fineGridStep{15.0};
+  static constexpr double _coarseGridStep{150.0};
+
+  /**
+   * @brief _fineGridFadeStart, _fineGridFadeEnd On-screen spacing, in pixels, below which the fine
+   * grid lines start fading out and at which they are no longer drawn.
+   */
+  static constexpr double _fineGridFadeStart{8.0};
+  static constexpr double _fineGridFadeEnd{4.0};
 };
 }
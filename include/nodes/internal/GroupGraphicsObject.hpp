@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_map>
+
 #include <QtWidgets/QGraphicsRectItem>
 #include <QPen>
 
@@ -87,10 +89,30 @@ public:
 
   /**
    * @copydoc QGraphicsItem::boundingRect()
+   * @note The area is cached and only changes through updateBounds() and
+   * updateChildBounds(), so this call does not visit the group's nodes.
    */
   QRectF
   boundingRect() const override;
 
+  /**
+   * @brief Recomputes the group's area from the geometry of every child node
+   * (and of the possible child, if any). Called when nodes join or leave the
+   * group.
+   */
+  void
+  updateBounds();
+
+  /**
+   * @brief Updates the group's area after one of its nodes (or its possible
+   * child) moved or was resized. The area is only recomputed from all nodes
+   * when the node used to lie on its border, otherwise it just grows to
+   * include the node's new geometry.
+   * @param ngo Graphics object of the node whose geometry changed.
+   */
+  void
+  updateChildBounds(NodeGraphicsObject const& ngo);
+
   enum { Type = UserType + 3 };
 
   /**
@@ -209,15 +231,59 @@ protected:
   hoverLeaveEvent(QGraphicsSceneHoverEvent* event) override;
 
 
+  /** @copydoc QGraphicsItem::mousePressEvent() */
+  void
+  mousePressEvent(QGraphicsSceneMouseEvent* event) override;
+
+
   /** @copydoc QGraphicsItem::mouseMoveEvent() */
   void
   mouseMoveEvent(QGraphicsSceneMouseEvent* event) override;
 
 
+  /** @copydoc QGraphicsItem::mouseReleaseEvent() */
+  void
+  mouseReleaseEvent(QGraphicsSceneMouseEvent* event) override;
+
+
   /** @copydoc QGraphicsItem::mouseDoubleClickEvent() */
   void
   mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event) override;
 
+private:
+  /**
+   * @brief Returns the area covered by the given node, in scene coordinates.
+   */
+  static QRectF
+  childSceneRect(NodeGraphicsObject const& ngo);
+
+  /**
+   * @brief Stores the given area (in scene coordinates, without margins) and
+   * announces the geometry change, if the area actually changed.
+   */
+  void
+  setSceneBounds(QRectF const& sceneBounds);
+
+  /**
+   * @brief Translates the cached area of the group and of its nodes.
+   */
+  void
+  translateBounds(QPointF const& offset);
+
+  /**
+   * @brief Parents the group's nodes and the connections between them to
+   * this object, so that a drag moves them as a single transform.
+   */
+  void
+  beginDrag();
+
+  /**
+   * @brief Hands the nodes and connections parented by beginDrag() back to
+   * the scene at their new positions and reports the move once.
+   */
+  void
+  endDrag();
+
 public:
 
   /**
@@ -273,6 +339,35 @@ private:
    */
   bool _locked;
 
+  /**
+   * @brief _sceneBounds Cached union of the areas of the group's nodes, in
+   * scene coordinates and without the group's margins.
+   */
+  QRectF _sceneBounds;
+
+  /**
+   * @brief _childRects Last known area of each node included in _sceneBounds,
+   * in scene coordinates.
+   */
+  std::unordered_map<NodeGraphicsObject const*, QRectF> _childRects;
+
+  /**
+   * @brief _movingNodes Set while moveNodes() translates all the nodes at
+   * once, so that the individual node moves are not tracked.
+   */
+  bool _movingNodes;
+
+  /**
+   * @brief _dragging Set while the group is dragged with its nodes and
+   * internal connections parented to it.
+   */
+  bool _dragging;
+
+  /**
+   * @brief _dragStartPos Position of the group when the drag started.
+   */
+  QPointF _dragStartPos;
+
   static constexpr double _groupBorderX = 25.0;
   static constexpr double _groupBorderY = _groupBorderX * 0.8;
   static constexpr double _roundedBorderRadius = _groupBorderY;
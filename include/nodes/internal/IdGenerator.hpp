@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QtCore/QUuid>
+#include <QtCore/QtGlobal>
+
+#include "Export.hpp"
+
+namespace QtNodes
+{
+
+/// Process-unique, monotonically increasing identifier of a scene object.
+using ObjectId = quint64;
+
+/**
+ * @brief The IdGenerator class hands out the runtime identities of nodes,
+ * connections and groups. Ids are plain counters, and the UUIDs used for
+ * serialization are derived from them on demand instead of being read from
+ * the system random source for every object.
+ */
+class NODE_EDITOR_PUBLIC IdGenerator
+{
+public:
+
+  /**
+   * @brief Returns a new id. Ids start at 1 and are never reused within the
+   * process; 0 is never returned.
+   */
+  static
+  ObjectId
+  next();
+
+  /**
+   * @brief Returns the UUID standing for the given id. It combines a random
+   * prefix, drawn once per process, with the id, so that UUIDs of different
+   * ids never collide and UUIDs of different processes are unlikely to.
+   */
+  static
+  QUuid
+  uuid(ObjectId id);
+
+  /**
+   * @brief Returns the id a UUID returned by uuid() stands for, or 0 if the
+   * UUID wasn't produced by this process, e.g. because it was read from a file.
+   */
+  static
+  ObjectId
+  objectId(QUuid const& uuid);
+};
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "NodeData.hpp"
+
+namespace QtNodes
+{
+
+/**
+ * @brief The ModelDescriptor struct holds what the library needs to know
+ * about a node model before any instance of it exists: its unique name, the
+ * category and caption it is listed under, and its port signature.
+ *
+ * Models can provide it as `static ModelDescriptor Descriptor()`, or it can
+ * be passed to DataModelRegistry::registerModel() along with a creator. In
+ * both cases the model is only instantiated when a node is created.
+ */
+struct ModelDescriptor
+{
+  /// Same value as NodeDataModel::name()
+  QString name;
+
+  /// Registration category; empty to use the one given to registerModel()
+  QString category;
+
+  /// Same value as NodeDataModel::caption(); defaults to the name
+  QString caption;
+
+  std::vector<NodeDataType> inputs;
+
+  std::vector<NodeDataType> outputs;
+};
+}
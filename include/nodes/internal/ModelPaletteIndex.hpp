@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "Export.hpp"
+
+namespace QtNodes
+{
+
+class DataModelRegistry;
+
+/**
+ * @brief The ModelPaletteIndex class lists the models of a registry sorted by
+ * name, along with an index of the 1, 2 and 3 character substrings of their
+ * names. Filtering then intersects a few short posting lists instead of
+ * scanning every name, which keeps the model palette responsive with
+ * thousands of registered models.
+ */
+class NODE_EDITOR_PUBLIC ModelPaletteIndex
+{
+public:
+
+  struct Entry
+  {
+    QString name;
+    QString category;
+  };
+
+  /// Rebuilds the index if the registry changed since it was last built
+  void
+  update(DataModelRegistry const& registry);
+
+  /// Registered models, sorted by name
+  std::vector<Entry> const&
+  entries() const
+  {
+    return _entries;
+  }
+
+  /**
+   * @brief Returns the indices, in entries(), of the models whose name
+   * contains `filter`, ignoring case. Indices are in ascending order.
+   */
+  std::vector<std::uint32_t>
+  match(QString const& filter) const;
+
+private:
+
+  using GramKey = quint64;
+
+  static
+  GramKey
+  gramKey(QString const& text, int position, int length);
+
+private:
+
+  /// Registry revision the index was built for
+  quint64 _revision = 0;
+
+  std::vector<Entry> _entries;
+
+  /// Case-folded names, in the order of `_entries`
+  std::vector<QString> _foldedNames;
+
+  /// Ascending entry indices for every substring of up to three characters
+  std::unordered_map<GramKey, std::vector<std::uint32_t>> _grams;
+};
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "NodeDataModel.hpp"
+
+namespace QtNodes
+{
+
+/**
+ * @brief Function every model plugin library exports, unmangled, under the
+ * name ModelPluginEntryPoint:
+ *
+ *     extern "C" Q_DECL_EXPORT QtNodes::NodeDataModel*
+ *     qtnodes_create_model(char const* modelName);
+ *
+ * It returns a new instance of the named model, owned by the caller, or
+ * nullptr if the library doesn't provide that model.
+ *
+ * The library is described by a JSON manifest, which lets
+ * DataModelRegistry::registerPlugin() list its models without loading it:
+ *
+ *     {
+ *       "library": "mathmodels",
+ *       "models": [
+ *         {
+ *           "name": "Addition",
+ *           "category": "Math",
+ *           "caption": "Addition",
+ *           "inputs":  [ { "id": "decimal", "name": "Decimal" },
+ *                        { "id": "decimal", "name": "Decimal" } ],
+ *           "outputs": [ { "id": "decimal", "name": "Decimal" } ]
+ *         }
+ *       ]
+ *     }
+ *
+ * "library" is resolved relative to the manifest and may omit the platform
+ * specific prefix and suffix, as with QLibrary.
+ */
+using ModelPluginCreateFunction = NodeDataModel* (*)(char const* modelName);
+
+static constexpr char const* ModelPluginEntryPoint = "qtnodes_create_model";
+}
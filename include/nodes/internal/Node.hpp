@@ -9,9 +9,12 @@
 #include "PortType.hpp"
 
 #include "Export.hpp"
+#include "IdGenerator.hpp"
 #include "NodeState.hpp"
 #include "NodeGeometry.hpp"
 #include "NodeData.hpp"
+#include "OutputCache.hpp"
+#include "DiskResultCache.hpp"
 #include "NodeGraphicsObject.hpp"
 #include "ConnectionGraphicsObject.hpp"
 #include "Serializable.hpp"
@@ -62,9 +65,15 @@ public:
 
 public:
 
+  /// UUID of the node, derived from its runtime id on first use unless
+  /// restored with retrieveID().
   QUuid
   id() const;
 
+  /// Runtime identity of the node, see IdGenerator.
+  ObjectId
+  objectId() const;
+
   void
   reactToPossibleConnection(PortType,
                             NodeDataType const &,
@@ -110,12 +119,53 @@ public:
 
   bool isInGroup() const;
 
+  /**
+   * @brief Makes the node memoize its outputs in the given cache, or stop
+   * doing so if it is null. When the inputs and the saved model state match
+   * an entry, the cached outputs are sent downstream and the model isn't
+   * given the inputs; it receives them before it next computes.
+   */
+  void
+  setOutputCache(std::shared_ptr<OutputCache> cache);
+
+  std::shared_ptr<OutputCache> const&
+  outputCache() const;
+
+  /**
+   * @brief Makes the node look its outputs up in, and write them to, the
+   * given on-disk cache, or stop doing so if it is null. It is consulted
+   * after the output cache, and only for inputs with content hashes.
+   */
+  void
+  setResultCache(std::shared_ptr<DiskResultCache> cache);
+
+  std::shared_ptr<DiskResultCache> const&
+  resultCache() const;
+
+  /// Data sent downstream from the given output port: the pinned output of
+  /// a frozen node, the model's output, or the cached one if the model didn't
+  /// compute it
+  std::shared_ptr<NodeData>
+  outData(PortIndex index) const;
+
+  /**
+   * @brief Freezing pins the node's current outputs: incoming data is
+   * recorded but no longer reaches the model, and the pinned outputs are
+   * served downstream. Unfreezing gives the model the inputs it missed and
+   * sends its outputs downstream again.
+   */
+  void
+  setFrozen(bool frozen);
+
+  bool
+  isFrozen() const;
+
 public Q_SLOTS: // data propagation
 
   /// Propagates incoming data to the underlying model.
   void
   propagateData(std::shared_ptr<NodeData> nodeData,
-                PortIndex inPortIndex) const;
+                PortIndex inPortIndex);
 
   /// Fetches data from model's OUT #index port
   /// and propagates it to the connection
@@ -126,11 +176,74 @@ public Q_SLOTS: // data propagation
   void
   onNodeSizeUpdated();
 
+private Q_SLOTS:
+
+  /// Output data reported by the model itself
+  void
+  onModelDataUpdated(PortIndex index);
+
+  void
+  onProcessingStatusChanged();
+
+private:
+
+  /// Refreshes the node's layout and painting after its model got new inputs
+  void
+  updateGraphics();
+
+  /// Compact JSON of the model's save(), the state part of cache keys
+  QByteArray
+  modelState() const;
+
+  OutputCache::Key
+  outputCacheKey(QByteArray const& state) const;
+
+  /// Sends cached outputs downstream in place of the model's
+  void
+  serveCachedOutputs(OutputCache::Outputs outputs);
+
+  /// Gives the model the inputs it missed while outputs were served from
+  /// the cache, except for `skippedPort`, without letting it report
+  void
+  restoreModelInputs(PortIndex skippedPort);
+
+  /// Stores the model's outputs in the caches once the model is done
+  /// reporting them, rather than once per output port it reports
+  void
+  scheduleCacheUpdate();
+
+  void
+  updateCaches();
+
+  /// Whether the model has a computation under way, which reports when done
+  bool
+  modelComputing() const;
+
+  /// Inputs are only recorded while a cache or freezing needs them
+  bool
+  recordsInputs() const;
+
+  /// Takes the inputs from the input connections when recording starts,
+  /// and drops them when it stops
+  void
+  updateInputRecording(bool wasRecording);
+
+  /// Marks the connections into the node as frozen or not
+  void
+  updateInputConnections();
+
+  /// Freezes a node saved frozen without readable pinned outputs, once the
+  /// scene it belongs to has been loaded
+  void
+  applyRestoredFreeze();
+
 private:
 
   // addressing
 
-  QUuid _uid;
+  ObjectId _objectId;
+
+  mutable QUuid _uid;
 
   std::weak_ptr<NodeGroup> _nodeGroup{};
 
@@ -145,5 +258,34 @@ private:
   NodeGeometry _nodeGeometry;
 
   std::unique_ptr<NodeGraphicsObject> _nodeGraphicsObject;
+
+  // output caching
+
+  std::shared_ptr<OutputCache> _outputCache;
+
+  std::shared_ptr<DiskResultCache> _resultCache;
+
+  /// Latest data received on each input port while recordsInputs(); part
+  /// of the cache key
+  std::vector<std::shared_ptr<NodeData>> _inputs;
+
+  /// Outputs served in place of the model's while it is behind its inputs
+  OutputCache::Outputs _cachedOutputs;
+
+  bool _modelInputsStale = false;
+
+  /// Inputs the model's last reported outputs were computed from
+  std::vector<std::shared_ptr<NodeData>> _reportedInputs;
+
+  bool _cacheUpdatePending = false;
+
+  // freezing
+
+  bool _frozen = false;
+
+  /// Outputs served downstream while the node is frozen
+  OutputCache::Outputs _frozenOutputs;
+
+  bool _freezeAfterLoad = false;
 };
 }
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <cstddef>
+#include <utility>
+
 #include <QtCore/QString>
 
+#include "DataTypeRegistry.hpp"
 #include "Export.hpp"
 
+class QDataStream;
+
 namespace QtNodes
 {
 
@@ -11,8 +17,57 @@ struct NodeDataType
 {
   QString id;
   QString name;
+
+  NodeDataType() = default;
+
+  NodeDataType(QString typeId, QString typeName)
+    : id(std::move(typeId))
+    , name(std::move(typeName))
+  {}
+
+  /// Interned handle of `id`, see DataTypeRegistry. The handle is computed on
+  /// first use and cached, so `id` must not change afterwards.
+  TypeHandle
+  handle() const
+  {
+    if (_handle == InvalidTypeHandle)
+      _handle = DataTypeRegistry::handle(id);
+
+    return _handle;
+  }
+
+  /// Whether handle() has already been computed for this value.
+  bool
+  hasHandle() const
+  {
+    return _handle != InvalidTypeHandle;
+  }
+
+private:
+
+  mutable TypeHandle _handle = InvalidTypeHandle;
 };
 
+/// Compares handles when both sides already carry one, and ids otherwise:
+/// interning a temporary just to compare it costs more than the string
+/// comparison it saves.
+inline
+bool
+operator==(NodeDataType const & d1, NodeDataType const & d2)
+{
+  if (d1.hasHandle() && d2.hasHandle())
+    return d1.handle() == d2.handle();
+
+  return d1.id == d2.id;
+}
+
+inline
+bool
+operator!=(NodeDataType const & d1, NodeDataType const & d2)
+{
+  return !(d1 == d2);
+}
+
 /// Class represents data transferred between nodes.
 /// @param type is used for comparing the types
 /// The actual data is stored in subtypes
@@ -24,10 +79,40 @@ public:
 
   virtual bool sameType(NodeData const &nodeData) const
   {
-    return (this->type().id == nodeData.type().id);
+    return (this->type() == nodeData.type());
   }
 
   /// Type for inner use
   virtual NodeDataType type() const = 0;
+
+  /// Interned handle of type(). Data classes with a static type can return
+  /// a cached handle (see staticTypeHandle()) to make type checks string free.
+  virtual TypeHandle typeHandle() const
+  {
+    return type().handle();
+  }
+
+  /// Hash of the data's content, or 0 if there is none. Output caches key
+  /// data with a content hash by it, so equal data produced twice is
+  /// recognized; other data is only recognized by its identity.
+  virtual quint64 contentHash() const
+  {
+    return 0;
+  }
+
+  /// Approximate number of bytes held by the data, used by caches to honor
+  /// their memory budget.
+  virtual std::size_t memoryUsage() const
+  {
+    return 0;
+  }
+
+  /// Writes the data for a DiskResultCache, which reads it back with the
+  /// deserializer registered for its type. Returns false if the data can't
+  /// be serialized, which is the default.
+  virtual bool serialize(QDataStream &) const
+  {
+    return false;
+  }
 };
 }
@@ -9,6 +9,7 @@
 #include "NodeGeometry.hpp"
 #include "NodeStyle.hpp"
 #include "NodePainterDelegate.hpp"
+#include "PropagationPolicy.hpp"
 #include "Export.hpp"
 #include "memory.hpp"
 
@@ -132,12 +133,55 @@ public:
     return ConnectionPolicy::Many;
   }
 
+  /// Initial propagation policy of the connections from an output port.
+  /// Sources emitting at a high rate can hold their values back with
+  /// PropagationPolicy::latestValue().
+  virtual
+  PropagationPolicy
+  portPropagationPolicy(PortIndex) const
+  {
+    return PropagationPolicy::immediate();
+  }
+
   NodeStyle const&
   nodeStyle() const;
 
+  /**
+   * @brief Gives this model its own style. Models given equal styles share a
+   * single instance, see StyleCollection::sharedNodeStyle().
+   */
   void
   setNodeStyle(NodeStyle const& style);
 
+  /**
+   * @brief Shares an existing style with this model, so that several
+   * customized models can use a single instance.
+   */
+  void
+  setNodeStyle(std::shared_ptr<NodeStyle const> style);
+
+  /**
+   * @brief Returns a counter that is incremented whenever something displayed
+   * on the node may have changed. The node hosting the model increments it
+   * when the model reports new data, processing status or widget size.
+   * Views compare it against the value their cached layout was built for.
+   */
+  quint64
+  revision() const
+  {
+    return _revision;
+  }
+
+  /**
+   * @brief Marks the node's displayed text (caption, nickname, port captions,
+   * validation message) as changed outside of the model's usual signals.
+   */
+  void
+  invalidateLayout()
+  {
+    ++_revision;
+  }
+
 public:
 
   /// Triggers the algorithm
@@ -154,6 +198,51 @@ public:
   QWidget *
   embeddedWidget() = 0;
 
+  /**
+   * @brief Models returning true build their embedded widget on the first call
+   * to embeddedWidget(), which the library then defers until the node is first
+   * shown or interacted with. Until then, embeddedWidgetSizeHint() is used to
+   * lay the node out.
+   */
+  virtual
+  bool
+  embeddedWidgetDeferred() const
+  {
+    return false;
+  }
+
+  /**
+   * @brief Size the embedded widget will have once created. An empty size
+   * means that the model has no embedded widget.
+   */
+  virtual
+  QSize
+  embeddedWidgetSizeHint() const
+  {
+    return QSize();
+  }
+
+  /**
+   * @brief Returns the embedded widget if it may be used already, i.e. unless
+   * it is deferred and createEmbeddedWidget() hasn't been called yet.
+   */
+  QWidget *
+  createdEmbeddedWidget();
+
+  /**
+   * @brief Ends the deferral of the embedded widget and returns it. A model
+   * whose widget comes back as nullptr is treated as having no widget from
+   * then on, and embeddedWidget() isn't called again.
+   */
+  QWidget *
+  createEmbeddedWidget();
+
+  /**
+   * @brief Size of the embedded widget, or its size hint while it is deferred.
+   */
+  QSize
+  embeddedWidgetSize();
+
   virtual
   bool
   resizable() const
@@ -227,11 +316,23 @@ Q_SIGNALS:
   void
   computingFinished();
 
+  /// Emitted by models whose processingStatus() changed
+  void
+  processingStatusChanged();
+
   void embeddedWidgetSizeUpdated();
 
 private:
 
-  NodeStyle _nodeStyle;
+  /// Shared with StyleCollection until the model is given its own style
+  std::shared_ptr<NodeStyle const> _nodeStyle;
+
+  quint64 _revision = 0;
+
+  bool _embeddedWidgetCreated = false;
+
+  /// Set when the deferred widget turned out not to exist
+  bool _embeddedWidgetMissing = false;
 
 };
 }
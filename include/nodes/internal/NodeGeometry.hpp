@@ -3,10 +3,15 @@
 #include <QtCore/QRectF>
 #include <QtCore/QPointF>
 #include <QtGui/QTransform>
+#include <QtGui/QFont>
 #include <QtGui/QFontMetrics>
+#include <QtGui/QStaticText>
 #include <QIcon>
 
+#include <vector>
+
 #include "PortType.hpp"
+#include "DataTypeRegistry.hpp"
 #include "Export.hpp"
 #include "memory.hpp"
 
@@ -127,14 +132,61 @@ public:
   QRectF
   boundingRect() const;
 
-  /// Updates size unconditionally
+  /// Updates size and text layout unconditionally
   void
   recalculateSize() const;
 
-  /// Updates size if the QFontMetrics is changed
+  /// Updates size if the font, the number of ports or the model revision
+  /// changed since the layout was last computed
   void
   recalculateSize(QFont const &font) const;
 
+  /// Font the cached text layout was computed with
+  QFont const&
+  font() const
+  {
+    return _textMetrics->font;
+  }
+
+  /// Pre-laid-out labels; valid until the next recalculateSize()
+  QStaticText const&
+  captionText() const
+  {
+    return _captionText;
+  }
+
+  QStaticText const&
+  nicknameText() const
+  {
+    return _nicknameText;
+  }
+
+  QStaticText const&
+  validationText() const
+  {
+    return _validationText;
+  }
+
+  QStaticText const&
+  portText(PortType portType, PortIndex index) const;
+
+  /// Interned data type of a port; valid until the next recalculateSize()
+  TypeHandle
+  portTypeHandle(PortType portType, PortIndex index) const;
+
+  /// Distance from the top of a label to its baseline
+  int
+  textAscent() const
+  {
+    return _textAscent;
+  }
+
+  int
+  boldTextAscent() const
+  {
+    return _boldTextAscent;
+  }
+
   // TODO removed default QTransform()
   QPointF
   portScenePosition(PortIndex index,
@@ -213,6 +265,23 @@ private:
   unsigned int
   portWidth(PortType portType) const;
 
+  /// Measures every displayed string once and prepares the static texts
+  void
+  updateTextLayout() const;
+
+  struct TextMetrics;
+  struct StatusIcons;
+
+  /// Returns the metrics shared by every geometry laid out with `font`
+  static
+  std::shared_ptr<TextMetrics const>
+  sharedTextMetrics(QFont const& font);
+
+  /// Returns the processing status icons shared by every geometry
+  static
+  std::shared_ptr<StatusIcons const>
+  sharedStatusIcons();
+
 private:
 
   // some variables are mutable because
@@ -241,18 +310,42 @@ private:
 
   std::unique_ptr<NodeDataModel> const &_dataModel;
 
-  mutable QFontMetrics _fontMetrics;
-  mutable QFontMetrics _boldFontMetrics;
+  /**
+   * @brief Font and font metrics, shared with all the geometries that use
+   * the same font.
+   */
+  mutable std::shared_ptr<TextMetrics const> _textMetrics;
+
+  /**
+   * @brief Text layout cache. It is rebuilt by recalculateSize() and keyed by
+   * the font, the port counts and the model revision it was built for.
+   */
+  mutable quint64 _layoutRevision;
+  mutable unsigned int _layoutSinks;
+  mutable unsigned int _layoutSources;
+  mutable bool _layoutValid;
+
+  mutable unsigned int _captionHeight;
+  mutable unsigned int _captionWidth;
+  mutable unsigned int _nicknameHeight;
+  mutable unsigned int _nicknameWidth;
+  mutable unsigned int _validationHeight;
+  mutable unsigned int _validationWidth;
+  mutable int _textAscent;
+  mutable int _boldTextAscent;
+
+  mutable QStaticText _captionText;
+  mutable QStaticText _nicknameText;
+  mutable QStaticText _validationText;
+  mutable std::vector<QStaticText> _inPortTexts;
+  mutable std::vector<QStaticText> _outPortTexts;
+  mutable std::vector<TypeHandle> _inPortTypes;
+  mutable std::vector<TypeHandle> _outPortTypes;
 
   /**
-   * @brief Processing status icons
+   * @brief Processing status icons, shared by all nodes
    */
-  const QIcon _statusUpdated{"://status_icons/updated.svg"};
-  const QIcon _statusProcessing{"://status_icons/processing.svg"};
-  const QIcon _statusPending{"://status_icons/pending.svg"};
-  const QIcon _statusInvalid{"://status_icons/failed.svg"};
-  const QIcon _statusEmpty{"://status_icons/empty.svg"};
-  const QIcon _statusPartial{"://status_icons/partial.svg"};
+  std::shared_ptr<StatusIcons const> _statusIcons;
 
 };
 }
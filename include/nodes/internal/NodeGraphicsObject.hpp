@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QtCore/QUuid>
+#include <QtGui/QPixmap>
 #include <QtWidgets/QGraphicsObject>
 
 #include "Connection.hpp"
@@ -9,6 +10,7 @@
 #include "NodeState.hpp"
 
 class QGraphicsProxyWidget;
+class QTimer;
 
 namespace QtNodes
 {
@@ -42,6 +44,9 @@ public:
   QRectF
   boundingRect() const override;
 
+  QPainterPath
+  shape() const override;
+
   void
   setGeometryChanged();
 
@@ -68,6 +73,72 @@ public:
   void
   updateGeometry();
 
+  /**
+   * @brief Lets the node's group (or the group the node is being dragged
+   * into) account for a change in the node's position or size.
+   */
+  void
+  updateGroupBounds();
+
+  /**
+   * @brief Moves the node without recomputing its connections or reporting
+   * the move. Used by FlowScene to apply drags in batches, see
+   * FlowScene::queueNodeDrag().
+   */
+  void
+  moveBatched(QPointF const& offset);
+
+  /**
+   * @brief Expands or releases the group the node is being dragged into.
+   * Colliding groups are only looked up when the node crossed the border of
+   * a group since it covered `previousSceneRect`.
+   */
+  void
+  updateGroupHover(QRectF const& previousSceneRect);
+
+  /**
+   * @brief Shows the embedded widget through its live proxy, or hides the
+   * proxy and paints a cached snapshot of the widget instead. Snapshots are
+   * only used when the scene has widget snapshots enabled.
+   */
+  void
+  setWidgetLive(bool live);
+
+  bool
+  isWidgetLive() const
+  {
+    return _widgetLive;
+  }
+
+  /**
+   * @brief Refreshes the snapshot of the embedded widget shortly after the
+   * node changed. Calls made before the refresh are coalesced into it.
+   */
+  void
+  scheduleWidgetSnapshot();
+
+  /**
+   * @brief Creates and embeds the model's widget if its creation was deferred
+   * (see NodeDataModel::embeddedWidgetDeferred()). Does nothing otherwise.
+   */
+  void
+  createDeferredWidget();
+
+  /**
+   * @brief Queues createDeferredWidget() for the next event loop iteration.
+   * Called by the scene when the node comes into view; only the first call
+   * has an effect.
+   */
+  void
+  requestDeferredWidget();
+
+  /**
+   * @brief Called by a virtualized scene when the node is parked or attached
+   * again. A parked node releases its widget proxy and its cached pixmaps.
+   */
+  void
+  setParked(bool parked);
+
 protected:
   void
   paint(QPainter*                       painter,
@@ -105,6 +176,16 @@ private:
   void
   embedQWidget();
 
+  void
+  paintWidgetSnapshot(QPainter* painter);
+
+  void
+  takeWidgetSnapshot();
+
+  /// Swaps the live widget out once the user stopped interacting with it.
+  void
+  scheduleWidgetRelease();
+
 private:
 
   FlowScene & _scene;
@@ -121,5 +202,33 @@ private:
 
   // either nullptr or owned by parent QGraphicsItem
   QGraphicsProxyWidget * _proxyWidget;
+
+  bool _widgetLive;
+
+  QPixmap _widgetSnapshot;
+
+  /// Model revision the snapshot was taken at.
+  quint64 _widgetSnapshotRevision;
+
+  // created on first use, owned by this object
+  QTimer * _widgetSnapshotTimer;
+
+  /// Delay, in ms, between a change of the node and the refresh of its snapshot.
+  static constexpr int _widgetSnapshotDelay{100};
+
+  // created on first use, owned by this object
+  QTimer * _widgetReleaseTimer;
+
+  /// Inactivity delay, in ms, after which the live widget is swapped out.
+  static constexpr int _widgetReleaseDelay{1500};
+
+  /// Set while the node is parked and its widget is out of its proxy.
+  bool _widgetDetached;
+
+  /// Set once requestDeferredWidget() queued the creation of the widget.
+  bool _widgetCreationRequested;
+
+  /// Set while moveBatched() moves the node.
+  bool _movingBatched;
 };
 }
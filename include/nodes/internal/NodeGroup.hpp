@@ -98,6 +98,18 @@ public:
    */
   bool empty() const;
 
+  /**
+   * @brief Freezes or unfreezes every node of the group, see Node::setFrozen().
+   */
+  void
+  setFrozen(bool frozen);
+
+  /**
+   * @brief Returns whether the group has nodes and all of them are frozen.
+   */
+  bool
+  isFrozen() const;
+
   /**
    * @brief Returns the number of groups created during the program's execution.
    * Used when automatically naming groups.
@@ -3,9 +3,8 @@
 #include <vector>
 #include <unordered_map>
 
-#include <QtCore/QUuid>
-
 #include "Export.hpp"
+#include "IdGenerator.hpp"
 
 #include "PortType.hpp"
 #include "NodeData.hpp"
@@ -34,8 +33,9 @@ public:
 
 public:
 
+  /// Connections keyed by their Connection::objectId().
   using ConnectionPtrSet =
-          std::unordered_map<QUuid, Connection*>;
+          std::unordered_map<ObjectId, Connection*>;
 
   /// Returns vector of connections ID.
   /// Some of them can be empty (null)
@@ -56,7 +56,7 @@ public:
   void
   eraseConnection(PortType portType,
                   PortIndex portIndex,
-                  QUuid id);
+                  ObjectId id);
 
   ReactToConnectionState
   reaction() const;
@@ -64,7 +64,7 @@ public:
   PortType
   reactingPortType() const;
 
-  NodeDataType
+  NodeDataType const&
   reactingDataType() const;
 
   void
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "IdGenerator.hpp"
+#include "NodeData.hpp"
+#include "Export.hpp"
+
+namespace QtNodes
+{
+
+/**
+ * @brief The OutputCache class memoizes node outputs by the inputs and the
+ * persisted state they were computed from. Nodes opt in with
+ * Node::setOutputCache(), and several nodes may share one cache, and thus one
+ * memory budget. The least recently used entries are evicted first.
+ */
+class NODE_EDITOR_PUBLIC OutputCache
+{
+public:
+
+  using Outputs = std::vector<std::shared_ptr<NodeData>>;
+
+  /// What a node's outputs depend on
+  struct Key
+  {
+    ObjectId node = 0;
+
+    /// Compact JSON of the model's save()
+    QByteArray state;
+
+    /// Two values per input port: its kind (none, content hash or identity,
+    /// with the type handle) and the content hash or the data address
+    std::vector<quint64> inputs;
+
+    bool
+    operator==(Key const& other) const
+    {
+      return node == other.node &&
+             inputs == other.inputs &&
+             state == other.state;
+    }
+  };
+
+  struct Stats
+  {
+    quint64 hits = 0;
+
+    quint64 misses = 0;
+
+    quint64 evictions = 0;
+
+    std::size_t entries = 0;
+
+    /// Estimated bytes held by the entries, see NodeData::memoryUsage()
+    std::size_t memoryUsage = 0;
+  };
+
+  static constexpr std::size_t DefaultMemoryBudget = 64 * 1024 * 1024;
+
+public:
+
+  explicit
+  OutputCache(std::size_t memoryBudget = DefaultMemoryBudget);
+
+  OutputCache(OutputCache const&) = delete;
+
+  OutputCache&
+  operator=(OutputCache const&) = delete;
+
+  /**
+   * @brief Builds the key of a node's outputs. Inputs with a content hash
+   * are keyed by it; the others by their address, in which case the cache
+   * keeps them alive while the entry exists so that the address can't be
+   * reused by other data.
+   */
+  static
+  Key
+  makeKey(ObjectId node,
+          QByteArray state,
+          std::vector<std::shared_ptr<NodeData>> const& inputs);
+
+  /// Cached outputs for the key, or nullptr. Counts as a hit or a miss.
+  Outputs const*
+  find(Key const& key);
+
+  void
+  insert(Key key,
+         Outputs outputs,
+         std::vector<std::shared_ptr<NodeData>> const& inputs);
+
+  /// Drops the entries of a node, e.g. when it is deleted
+  void
+  remove(ObjectId node);
+
+  void
+  clear();
+
+  std::size_t
+  memoryBudget() const
+  {
+    return _memoryBudget;
+  }
+
+  /// Changing the budget evicts entries until it is honored
+  void
+  setMemoryBudget(std::size_t bytes);
+
+  Stats
+  stats() const;
+
+  /// Resets the hit, miss and eviction counters
+  void
+  resetStats();
+
+private:
+
+  struct KeyHash
+  {
+    std::size_t
+    operator()(Key const& key) const;
+  };
+
+  struct Entry
+  {
+    Key key;
+
+    Outputs outputs;
+
+    /// Inputs keyed by their address
+    std::vector<std::shared_ptr<NodeData>> pinnedInputs;
+
+    std::size_t memoryUsage;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void
+  evict(std::size_t budget);
+
+private:
+
+  std::size_t _memoryBudget;
+
+  std::size_t _memoryUsage = 0;
+
+  /// Most recently used first
+  EntryList _entries;
+
+  std::unordered_map<Key, EntryList::iterator, KeyHash> _index;
+
+  quint64 _hits = 0;
+
+  quint64 _misses = 0;
+
+  quint64 _evictions = 0;
+};
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+namespace QtNodes
+{
+
+/**
+ * @brief The PropagationPolicy struct defines how a connection passes the
+ * data of its output port on to its input port.
+ */
+struct PropagationPolicy
+{
+  enum class Mode
+  {
+    /// Every value is delivered as soon as it is sent
+    Immediate,
+
+    /// Values are delivered at most `maxRate` times per second. A value
+    /// sent before the next delivery is due waits for the scene's next tick,
+    /// and is replaced by any value sent in the meantime
+    LatestValue,
+  };
+
+  Mode mode = Mode::Immediate;
+
+  /// Deliveries per second in LatestValue mode
+  double maxRate = 30.0;
+
+  static
+  PropagationPolicy
+  immediate()
+  {
+    return PropagationPolicy();
+  }
+
+  static
+  PropagationPolicy
+  latestValue(double maxRate)
+  {
+    return PropagationPolicy{Mode::LatestValue, maxRate};
+  }
+};
+
+
+/// Counters of the values sent through a connection
+struct PropagationStats
+{
+  quint64 received = 0;
+
+  quint64 delivered = 0;
+
+  /// Values replaced by a newer one before they were delivered
+  quint64 dropped = 0;
+};
+}
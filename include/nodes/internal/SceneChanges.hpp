@@ -0,0 +1,91 @@
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QtCore/QPointF>
+#include <QtCore/QUuid>
+
+#include "QUuidStdHash.hpp"
+#include "Export.hpp"
+
+namespace QtNodes
+{
+
+/**
+ * @brief The SceneChanges struct lists the changes made to a FlowScene during
+ * one frame, see FlowScene::changesCommitted(). Every item appears at most
+ * once per array, and items created and deleted within the same frame are
+ * not listed at all.
+ */
+struct NODE_EDITOR_PUBLIC SceneChanges
+{
+  std::vector<QUuid> createdNodes;
+
+  std::vector<QUuid> deletedNodes;
+
+  /// Moved nodes, with their last position at the same index of
+  /// movedNodePositions.
+  std::vector<QUuid> movedNodes;
+
+  std::vector<QPointF> movedNodePositions;
+
+  /// Nodes whose model reported updated output data.
+  std::vector<QUuid> updatedNodes;
+
+  std::vector<QUuid> createdConnections;
+
+  std::vector<QUuid> deletedConnections;
+
+  bool
+  empty() const;
+};
+
+/**
+ * @brief The SceneChangeAccumulator class collects individual scene changes
+ * into a SceneChanges set, collapsing repeated changes of the same item.
+ */
+class NODE_EDITOR_PUBLIC SceneChangeAccumulator
+{
+public:
+
+  void
+  nodeCreated(QUuid const& id);
+
+  void
+  nodeDeleted(QUuid const& id);
+
+  void
+  nodeMoved(QUuid const& id, QPointF const& position);
+
+  void
+  nodeUpdated(QUuid const& id);
+
+  void
+  connectionCreated(QUuid const& id);
+
+  void
+  connectionDeleted(QUuid const& id);
+
+  bool
+  empty() const;
+
+  /// Returns the accumulated changes and starts a new, empty set.
+  SceneChanges
+  take();
+
+private:
+
+  SceneChanges _changes;
+
+  /// Index of each moved node in _changes.movedNodes.
+  std::unordered_map<QUuid, std::size_t> _movedIndices;
+
+  std::unordered_set<QUuid> _createdNodes;
+
+  std::unordered_set<QUuid> _updatedNodes;
+
+  std::unordered_set<QUuid> _createdConnections;
+};
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "NodeStyle.hpp"
 #include "ConnectionStyle.hpp"
 #include "FlowViewStyle.hpp"
@@ -16,6 +19,24 @@ public:
   NodeStyle const&
   nodeStyle();
 
+  /**
+   * @brief Returns the current default node style as a shared, immutable
+   * instance. Models keep a reference to it instead of a copy until they are
+   * given a style of their own.
+   */
+  static
+  std::shared_ptr<NodeStyle const>
+  sharedNodeStyle();
+
+  /**
+   * @brief Returns a shared instance holding the same values as `style`.
+   * Customized models with equal styles end up sharing one copy, and a style
+   * equal to the default shares the default instance.
+   */
+  static
+  std::shared_ptr<NodeStyle const>
+  sharedNodeStyle(NodeStyle const& style);
+
   static
   ConnectionStyle const&
   connectionStyle();
@@ -40,7 +61,7 @@ public:
 
 private:
 
-  StyleCollection() = default;
+  StyleCollection();
 
   StyleCollection(StyleCollection const&) = delete;
 
@@ -53,7 +74,10 @@ private:
 
 private:
 
-  NodeStyle _nodeStyle;
+  /// Assigned in place, so references from nodeStyle() stay valid
+  std::shared_ptr<NodeStyle> _nodeStyle;
+
+  std::vector<std::weak_ptr<NodeStyle const>> _customNodeStyles;
 
   ConnectionStyle _connectionStyle;
 
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "NodeDataModel.hpp"
+#include "NodeData.hpp"
+#include "DataTypeRegistry.hpp"
+
+namespace QtNodes
+{
+
+/// Lists the data classes of a model's input ports, in port order
+template <typename... Types>
+struct Inputs
+{};
+
+/// Lists the data classes of a model's output ports, in port order
+template <typename... Types>
+struct Outputs
+{};
+
+/// Tags selecting the setTypedInData()/typedOutData() overload of a port
+template <PortIndex Index>
+using InPort = std::integral_constant<PortIndex, Index>;
+
+template <PortIndex Index>
+using OutPort = std::integral_constant<PortIndex, Index>;
+
+/**
+ * @brief Returns the interned handle of a data class's type. The class must
+ * provide `static NodeDataType staticType()`, whose id identifies the class:
+ * data reporting that id is assumed to be an instance of it.
+ */
+template <typename DataType>
+TypeHandle
+staticTypeHandle()
+{
+  static TypeHandle const handle = DataType::staticType().handle();
+
+  return handle;
+}
+
+namespace detail
+{
+
+template <PortIndex Index, typename DataType>
+class TypedInputPort
+{
+public:
+
+  virtual
+  ~TypedInputPort() = default;
+
+  /// Receives the port's data, or nullptr if it was reset or had another type
+  virtual
+  void
+  setTypedInData(std::shared_ptr<DataType> data, InPort<Index>) = 0;
+};
+
+
+template <PortIndex Index, typename DataType>
+class TypedOutputPort
+{
+public:
+
+  virtual
+  ~TypedOutputPort() = default;
+
+  virtual
+  std::shared_ptr<DataType>
+  typedOutData(OutPort<Index>) = 0;
+};
+
+
+template <typename Indices, typename... Types>
+class TypedInputPorts;
+
+template <std::size_t... Index, typename... Types>
+class TypedInputPorts<std::index_sequence<Index...>, Types...>
+  : public TypedInputPort<Index, Types>...
+{};
+
+
+template <typename Indices, typename... Types>
+class TypedOutputPorts;
+
+template <std::size_t... Index, typename... Types>
+class TypedOutputPorts<std::index_sequence<Index...>, Types...>
+  : public TypedOutputPort<Index, Types>...
+{};
+}
+
+
+template <typename InputList, typename OutputList>
+class TypedNodeDataModel;
+
+/**
+ * @brief The TypedNodeDataModel class implements the port description and
+ * the data entry points of NodeDataModel from the port data classes given as
+ * template arguments:
+ *
+ *     class SumModel
+ *       : public TypedNodeDataModel<Inputs<DecimalData, DecimalData>,
+ *                                   Outputs<DecimalData>>
+ *     {
+ *       void setTypedInData(std::shared_ptr<DecimalData>, InPort<0>) override;
+ *       void setTypedInData(std::shared_ptr<DecimalData>, InPort<1>) override;
+ *       std::shared_ptr<DecimalData> typedOutData(OutPort<0>) override;
+ *       ...
+ *     };
+ *
+ * nPorts(), dataType() and portCaption() are generated, and incoming data is
+ * checked with one handle comparison and passed on with a static_pointer_cast
+ * instead of a dynamic_pointer_cast per input. The typed hooks are named
+ * apart from setInData()/outData() so they don't hide the generic entry
+ * points the scene calls through NodeDataModel.
+ */
+template <typename... InTypes, typename... OutTypes>
+class TypedNodeDataModel<Inputs<InTypes...>, Outputs<OutTypes...>>
+  : public NodeDataModel
+  , public detail::TypedInputPorts<std::index_sequence_for<InTypes...>, InTypes...>
+  , public detail::TypedOutputPorts<std::index_sequence_for<OutTypes...>, OutTypes...>
+{
+public:
+
+  unsigned int
+  nPorts(PortType portType) const override
+  {
+    switch (portType)
+    {
+      case PortType::In:
+        return sizeof...(InTypes);
+
+      case PortType::Out:
+        return sizeof...(OutTypes);
+
+      default:
+        return 0;
+    }
+  }
+
+  NodeDataType
+  dataType(PortType portType, PortIndex portIndex) const override
+  {
+    static std::array<NodeDataType, sizeof...(InTypes)> const inTypes =
+      { InTypes::staticType()... };
+    static std::array<NodeDataType, sizeof...(OutTypes)> const outTypes =
+      { OutTypes::staticType()... };
+
+    if (portIndex < 0)
+      return NodeDataType();
+
+    std::size_t const index = static_cast<std::size_t>(portIndex);
+
+    if (portType == PortType::In && index < inTypes.size())
+      return inTypes[index];
+
+    if (portType == PortType::Out && index < outTypes.size())
+      return outTypes[index];
+
+    return NodeDataType();
+  }
+
+  /// Port captions default to the names of the port data types
+  QString
+  portCaption(PortType portType, PortIndex portIndex) const override
+  {
+    return dataType(portType, portIndex).name;
+  }
+
+  void
+  setInData(std::shared_ptr<NodeData> data, PortIndex port) final
+  {
+    dispatchInData(data, port, std::index_sequence_for<InTypes...>{});
+  }
+
+  std::shared_ptr<NodeData>
+  outData(PortIndex port) final
+  {
+    return dispatchOutData(port, std::index_sequence_for<OutTypes...>{});
+  }
+
+private:
+
+  template <std::size_t... Index>
+  void
+  dispatchInData(std::shared_ptr<NodeData> const& data,
+                 PortIndex port,
+                 std::index_sequence<Index...>)
+  {
+    (void)((port == static_cast<PortIndex>(Index) &&
+            (forwardInData<Index, InTypes>(data), true)) || ...);
+  }
+
+  template <std::size_t Index, typename DataType>
+  void
+  forwardInData(std::shared_ptr<NodeData> const& data)
+  {
+    std::shared_ptr<DataType> typed;
+
+    if (data && data->typeHandle() == staticTypeHandle<DataType>())
+      typed = std::static_pointer_cast<DataType>(data);
+
+    static_cast<detail::TypedInputPort<Index, DataType>&>(*this)
+      .setTypedInData(std::move(typed), InPort<Index>{});
+  }
+
+  template <std::size_t... Index>
+  std::shared_ptr<NodeData>
+  dispatchOutData(PortIndex port, std::index_sequence<Index...>)
+  {
+    std::shared_ptr<NodeData> result;
+
+    (void)((port == static_cast<PortIndex>(Index) &&
+            (result = static_cast<detail::TypedOutputPort<Index, OutTypes>&>(*this)
+                      .typedOutData(OutPort<Index>{}), true)) || ...);
+
+    return result;
+  }
+};
+}
@@ -0,0 +1,240 @@
+#include "AsyncNodeDataModel.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include <QtCore/QDebug>
+#include <QtCore/QMetaObject>
+#include <QtCore/QReadWriteLock>
+
+using QtNodes::AsyncNodeDataModel;
+using QtNodes::CancellationToken;
+using QtNodes::ComputeScheduler;
+using QtNodes::NodeData;
+using QtNodes::NodeProcessingStatus;
+using QtNodes::PortIndex;
+using QtNodes::PortType;
+
+/// Shared with the jobs, which hold the lock for reading while they use the
+/// model; cancelAndWait() takes it for writing.
+struct AsyncNodeDataModel::Lifetime
+{
+  QReadWriteLock lock;
+
+  bool alive = true;
+};
+
+
+AsyncNodeDataModel::
+AsyncNodeDataModel()
+  : _lifetime(std::make_shared<Lifetime>())
+{}
+
+
+AsyncNodeDataModel::
+~AsyncNodeDataModel()
+{
+  cancelAndWait();
+}
+
+
+void
+AsyncNodeDataModel::
+cancelAndWait()
+{
+  _token.cancel();
+
+  QWriteLocker locker(&_lifetime->lock);
+
+  _lifetime->alive = false;
+}
+
+
+void
+AsyncNodeDataModel::
+setInData(std::shared_ptr<NodeData> nodeData,
+          PortIndex port)
+{
+  if (port < 0)
+    return;
+
+  _inputs.resize(std::max<std::size_t>(nPorts(PortType::In), port + 1));
+  _inputs[port] = std::move(nodeData);
+
+  recompute();
+}
+
+
+std::shared_ptr<NodeData>
+AsyncNodeDataModel::
+outData(PortIndex port)
+{
+  if (port < 0 || static_cast<std::size_t>(port) >= _outputs.size())
+    return nullptr;
+
+  return _outputs[port];
+}
+
+
+NodeProcessingStatus
+AsyncNodeDataModel::
+processingStatus() const
+{
+  return _status;
+}
+
+
+void
+AsyncNodeDataModel::
+setScheduler(std::shared_ptr<ComputeScheduler> scheduler)
+{
+  _scheduler = std::move(scheduler);
+}
+
+
+bool
+AsyncNodeDataModel::
+canCompute(Inputs const& inputs) const
+{
+  return std::all_of(inputs.begin(), inputs.end(),
+                     [](std::shared_ptr<NodeData> const& input)
+                     { return input != nullptr; });
+}
+
+
+void
+AsyncNodeDataModel::
+recompute()
+{
+  // whatever runs now computes from outdated inputs
+  _token.cancel();
+  _token = CancellationToken();
+
+  quint64 const generation = ++_generation;
+
+  _inputs.resize(std::max<std::size_t>(_inputs.size(), nPorts(PortType::In)));
+
+  if (!canCompute(_inputs))
+  {
+    _outputs.clear();
+
+    setStatus(NodeProcessingStatus::Empty);
+    emitOutputs();
+    return;
+  }
+
+  // stopped for good before being destroyed
+  if (!_lifetime->alive)
+    return;
+
+  setStatus(NodeProcessingStatus::Pending);
+
+  auto const& scheduler =
+    _scheduler ? _scheduler : ComputeScheduler::defaultScheduler();
+
+  scheduler->submit([this,
+                     lifetime = _lifetime,
+                     token = _token,
+                     inputs = _inputs,
+                     generation]() mutable
+  {
+    QReadLocker locker(&lifetime->lock);
+
+    // superseded while queued
+    if (!lifetime->alive || token.isCancelled())
+      return;
+
+    QMetaObject::invokeMethod(this,
+                              [this, generation]
+                              { onComputeStarted(generation); },
+                              Qt::QueuedConnection);
+
+    Outputs outputs;
+    bool failed = false;
+
+    try
+    {
+      outputs = compute(std::move(inputs), token);
+    }
+    catch (std::exception const& e)
+    {
+      qWarning() << "Computing" << name() << "failed:" << e.what();
+      failed = true;
+    }
+    catch (...)
+    {
+      qWarning() << "Computing" << name() << "failed";
+      failed = true;
+    }
+
+    if (token.isCancelled())
+      return;
+
+    QMetaObject::invokeMethod(this,
+                              [this, generation, failed,
+                               outputs = std::move(outputs)]() mutable
+                              {
+                                onComputeFinished(generation,
+                                                  std::move(outputs),
+                                                  failed);
+                              },
+                              Qt::QueuedConnection);
+  });
+}
+
+
+void
+AsyncNodeDataModel::
+onComputeStarted(quint64 generation)
+{
+  if (generation != _generation)
+    return;
+
+  setStatus(NodeProcessingStatus::Processing);
+
+  Q_EMIT computingStarted();
+}
+
+
+void
+AsyncNodeDataModel::
+onComputeFinished(quint64 generation, Outputs outputs, bool failed)
+{
+  // only the latest inputs' results are delivered
+  if (generation != _generation)
+    return;
+
+  if (failed)
+    outputs.clear();
+
+  _outputs = std::move(outputs);
+
+  setStatus(failed ? NodeProcessingStatus::Failed : NodeProcessingStatus::Updated);
+
+  Q_EMIT computingFinished();
+
+  emitOutputs();
+}
+
+
+void
+AsyncNodeDataModel::
+setStatus(NodeProcessingStatus status)
+{
+  if (status == _status)
+    return;
+
+  _status = status;
+
+  Q_EMIT processingStatusChanged();
+}
+
+
+void
+AsyncNodeDataModel::
+emitOutputs()
+{
+  for (unsigned int i = 0; i < nPorts(PortType::Out); ++i)
+    Q_EMIT dataUpdated(i);
+}
@@ -0,0 +1,70 @@
+#include "ComputeScheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using QtNodes::ComputeScheduler;
+
+ComputeScheduler::
+ComputeScheduler(int maxConcurrentJobs)
+{
+  setMaxConcurrentJobs(maxConcurrentJobs);
+}
+
+
+ComputeScheduler::
+~ComputeScheduler()
+{
+  _pool.waitForDone();
+}
+
+
+int
+ComputeScheduler::
+maxConcurrentJobs() const
+{
+  return _pool.maxThreadCount();
+}
+
+
+void
+ComputeScheduler::
+setMaxConcurrentJobs(int count)
+{
+  _pool.setMaxThreadCount(std::max(1, count));
+}
+
+
+void
+ComputeScheduler::
+submit(Job job)
+{
+  _pool.start(std::move(job));
+}
+
+
+int
+ComputeScheduler::
+activeJobs() const
+{
+  return _pool.activeThreadCount();
+}
+
+
+bool
+ComputeScheduler::
+waitForDone(int msecs)
+{
+  return _pool.waitForDone(msecs);
+}
+
+
+std::shared_ptr<ComputeScheduler> const&
+ComputeScheduler::
+defaultScheduler()
+{
+  static std::shared_ptr<ComputeScheduler> const scheduler =
+    std::make_shared<ComputeScheduler>();
+
+  return scheduler;
+}
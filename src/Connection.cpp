@@ -19,6 +19,8 @@
 #include "ConnectionGraphicsObject.hpp"
 
 using QtNodes::Connection;
+using QtNodes::ConnectionEvents;
+using QtNodes::IdGenerator;
 using QtNodes::PortType;
 using QtNodes::PortIndex;
 using QtNodes::ConnectionState;
@@ -28,12 +30,15 @@ using QtNodes::NodeDataType;
 using QtNodes::ConnectionGraphicsObject;
 using QtNodes::ConnectionGeometry;
 using QtNodes::TypeConverter;
+using QtNodes::TypeHandle;
+using QtNodes::PropagationPolicy;
+using QtNodes::PropagationStats;
 
 Connection::
 Connection(PortType portType,
            Node& node,
            PortIndex portIndex)
-  : _uid(QUuid::createUuid())
+  : _objectId(IdGenerator::next())
   , _outPortIndex(INVALID)
   , _inPortIndex(INVALID)
   , _connectionState()
@@ -50,7 +55,7 @@ Connection(Node& nodeIn,
            Node& nodeOut,
            PortIndex portIndexOut,
            TypeConverter typeConverter)
-  : _uid(QUuid::createUuid())
+  : _objectId(IdGenerator::next())
   , _outNode(&nodeOut)
   , _inNode(&nodeIn)
   , _outPortIndex(portIndexOut)
@@ -68,7 +73,7 @@ Connection::
 {
   if (complete())
   {
-    connectionMadeIncomplete(*this);
+    notify(&ConnectionEvents::madeIncomplete);
   }
 
   propagateEmptyData();
@@ -128,9 +133,20 @@ QUuid
 Connection::
 id() const
 {
+  if (_uid.isNull())
+    _uid = IdGenerator::uuid(_objectId);
+
   return _uid;
 }
 
+
+QtNodes::ObjectId
+Connection::
+objectId() const
+{
+  return _objectId;
+}
+
 bool
 Connection::
 complete() const
@@ -241,15 +257,17 @@ setPortIndex(const PortType portType,
   {
   case PortType::In:
     _inPortIndex = portIndex;
-    return;
+    break;
 
   case PortType::Out:
     _outPortIndex = portIndex;
-    return;
+    break;
 
   default:
     return;
   }
+
+  updateTypeHandle(portType);
 }
 
 
@@ -266,16 +284,26 @@ setNodeToPort(Node& node,
   nodeWeak = &node;
 
   if (portType == PortType::Out)
+  {
     _outPortIndex = portIndex;
+    _propagationPolicy = node.nodeDataModel()->portPropagationPolicy(portIndex);
+  }
   else
+  {
     _inPortIndex = portIndex;
 
+    // data doesn't flow into frozen nodes
+    _connectionGeometry.setFrozen(node.isFrozen());
+  }
+
+  updateTypeHandle(portType);
+
   _connectionState.setNoRequiredPort();
 
-  updated(*this);
+  notify(&ConnectionEvents::updated);
   if (complete() && wasIncomplete)
   {
-    connectionCompleted(*this);
+    notify(&ConnectionEvents::completed);
   }
 }
 
@@ -285,10 +313,10 @@ Connection::
 removeFromNodes() const
 {
   if (_inNode)
-    _inNode->nodeState().eraseConnection(PortType::In, _inPortIndex, id());
+    _inNode->nodeState().eraseConnection(PortType::In, _inPortIndex, _objectId);
 
   if (_outNode)
-    _outNode->nodeState().eraseConnection(PortType::Out, _outPortIndex, id());
+    _outNode->nodeState().eraseConnection(PortType::Out, _outPortIndex, _objectId);
 }
 
 
@@ -382,15 +410,22 @@ clearNode(PortType portType)
 {
   if (complete())
   {
-    connectionMadeIncomplete(*this);
+    notify(&ConnectionEvents::madeIncomplete);
   }
 
   getNode(portType) = nullptr;
 
   if (portType == PortType::In)
+  {
     _inPortIndex = INVALID;
+    _inTypeHandle = InvalidTypeHandle;
+    _connectionGeometry.setFrozen(false);
+  }
   else
+  {
     _outPortIndex = INVALID;
+    _outTypeHandle = InvalidTypeHandle;
+  }
 }
 
 
@@ -437,6 +472,36 @@ dataType(PortType portType) const
 }
 
 
+TypeHandle
+Connection::
+typeHandle(PortType portType) const
+{
+  // like dataType(), a loose end reports the type of the attached one
+  if (!_inNode || !_outNode)
+    return _inNode ? _inTypeHandle : _outTypeHandle;
+
+  return (portType == PortType::In) ? _inTypeHandle : _outTypeHandle;
+}
+
+
+void
+Connection::
+updateTypeHandle(PortType portType)
+{
+  Node* node = getNode(portType);
+  PortIndex const index = getPortIndex(portType);
+  TypeHandle& handle = (portType == PortType::In) ? _inTypeHandle : _outTypeHandle;
+
+  if (!node || index == INVALID)
+  {
+    handle = InvalidTypeHandle;
+    return;
+  }
+
+  handle = node->nodeDataModel()->dataType(portType, index).handle();
+}
+
+
 void
 Connection::
 setTypeConverter(TypeConverter converter)
@@ -449,15 +514,37 @@ void
 Connection::
 propagateData(std::shared_ptr<NodeData> nodeData) const
 {
-  if (_inNode)
+  if (!_inNode)
+    return;
+
+  ++_propagationStats.received;
+
+  // without a scene nothing would flush held back values
+  if (_propagationPolicy.mode == PropagationPolicy::Mode::Immediate ||
+      _events.expired())
   {
-    if (_converter)
-    {
-      nodeData = _converter(nodeData);
-    }
+    deliver(std::move(nodeData));
+    return;
+  }
+
+  if (_dataPending)
+  {
+    ++_propagationStats.dropped;
 
-    _inNode->propagateData(nodeData, _inPortIndex);
+    _pendingData = std::move(nodeData);
+    return;
   }
+
+  if (deliveryDue())
+  {
+    deliver(std::move(nodeData));
+    return;
+  }
+
+  _pendingData = std::move(nodeData);
+  _dataPending = true;
+
+  notify(&ConnectionEvents::throttled);
 }
 
 
@@ -465,7 +552,134 @@ void
 Connection::
 propagateEmptyData() const
 {
-  std::shared_ptr<NodeData> emptyData;
+  if (_dataPending)
+  {
+    ++_propagationStats.dropped;
+
+    _pendingData.reset();
+    _dataPending = false;
+  }
+
+  if (!_inNode)
+    return;
+
+  ++_propagationStats.received;
+
+  deliver(nullptr);
+}
+
+
+std::shared_ptr<NodeData>
+Connection::
+sourceData() const
+{
+  if (!_outNode)
+    return nullptr;
+
+  auto nodeData = _outNode->outData(_outPortIndex);
+
+  if (_converter)
+    nodeData = _converter(nodeData);
+
+  return nodeData;
+}
+
+
+void
+Connection::
+setPropagationPolicy(PropagationPolicy const& policy)
+{
+  _propagationPolicy = policy;
+}
+
+
+PropagationPolicy const&
+Connection::
+propagationPolicy() const
+{
+  return _propagationPolicy;
+}
+
+
+PropagationStats const&
+Connection::
+propagationStats() const
+{
+  return _propagationStats;
+}
+
+
+void
+Connection::
+resetPropagationStats()
+{
+  _propagationStats = PropagationStats();
+}
+
+
+bool
+Connection::
+flushPropagation() const
+{
+  if (!_dataPending)
+    return false;
 
-  propagateData(emptyData);
+  if (!deliveryDue())
+    return true;
+
+  std::shared_ptr<NodeData> nodeData = std::move(_pendingData);
+
+  _pendingData.reset();
+  _dataPending = false;
+
+  // a value held back again during the delivery reports itself
+  deliver(std::move(nodeData));
+
+  return false;
+}
+
+
+bool
+Connection::
+deliveryDue() const
+{
+  if (_propagationPolicy.mode == PropagationPolicy::Mode::Immediate ||
+      _propagationPolicy.maxRate <= 0.0)
+    return true;
+
+  std::chrono::duration<double> const interval(1.0 / _propagationPolicy.maxRate);
+
+  return std::chrono::steady_clock::now() - _lastDelivery >= interval;
+}
+
+
+void
+Connection::
+deliver(std::shared_ptr<NodeData> nodeData) const
+{
+  if (!_inNode)
+    return;
+
+  _lastDelivery = std::chrono::steady_clock::now();
+
+  ++_propagationStats.delivered;
+
+  if (_converter)
+  {
+    nodeData = _converter(nodeData);
+  }
+
+  _inNode->propagateData(nodeData, _inPortIndex);
+}
+
+
+void
+Connection::
+notify(std::vector<ConnectionEvents::Handler> ConnectionEvents::* handlers) const
+{
+  if (auto events = _events.lock())
+  {
+    for (auto const& handler : (*events).*handlers)
+      handler(*this);
+  }
 }
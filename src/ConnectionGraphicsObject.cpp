@@ -47,7 +47,9 @@ ConnectionGraphicsObject(FlowScene &scene,
 ConnectionGraphicsObject::
 ~ConnectionGraphicsObject()
 {
-  _scene.removeItem(this);
+  // parked items of a virtualized scene are not part of it
+  if (scene() == &_scene)
+    _scene.removeItem(this);
 }
 
 
@@ -196,13 +196,13 @@ drawNormalLine(QPainter * painter,
   {
     using QtNodes::PortType;
 
-    auto dataTypeOut = connection.dataType(PortType::Out);
-    auto dataTypeIn = connection.dataType(PortType::In);
+    auto typeOut = connection.typeHandle(PortType::Out);
+    auto typeIn  = connection.typeHandle(PortType::In);
 
-    gradientColor = (dataTypeOut.id != dataTypeIn.id);
+    gradientColor = (typeOut != typeIn);
 
-    normalColorOut  = connectionStyle.normalColor(dataTypeOut.id);
-    normalColorIn   = connectionStyle.normalColor(dataTypeIn.id);
+    normalColorOut  = connectionStyle.normalColor(typeOut);
+    normalColorIn   = connectionStyle.normalColor(typeIn);
     selectedColor = normalColorOut.darker(200);
     frozenColor = normalColorOut.darker(200);
 
@@ -1,5 +1,6 @@
 #include "ConnectionStyle.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include <QtCore/QFile>
@@ -13,6 +14,8 @@
 #include "StyleCollection.hpp"
 
 using QtNodes::ConnectionStyle;
+using QtNodes::DataTypeRegistry;
+using QtNodes::TypeHandle;
 
 inline void initResources() { Q_INIT_RESOURCE(resources); }
 
@@ -91,6 +94,23 @@ setConnectionStyle(QString jsonText)
       variable = valueRef.toBool(); \
 }
 
+static
+QColor
+colorFromJson(QJsonValue const& value)
+{
+  if (value.isArray())
+  {
+    auto colorArray = value.toArray();
+
+    return QColor(colorArray.at(0).toInt(),
+                  colorArray.at(1).toInt(),
+                  colorArray.at(2).toInt());
+  }
+
+  return QColor(value.toString());
+}
+
+
 void
 ConnectionStyle::
 loadJsonFile(QString styleFile)
@@ -140,6 +160,22 @@ loadJsonFromByteArray(QByteArray const &byteArray)
   CONNECTION_STYLE_READ_FLOAT(obj, PointDiameter);
 
   CONNECTION_STYLE_READ_BOOL(obj, UseDataDefinedColors);
+
+  QJsonObject typeColors = obj["DataTypeColors"].toObject();
+
+  // overrides of a previously loaded style don't carry over
+  _typeColorOverrides.clear();
+
+  for (auto it = typeColors.begin(); it != typeColors.end(); ++it)
+  {
+    QColor color = colorFromJson(it.value());
+
+    if (color.isValid())
+      _typeColorOverrides[DataTypeRegistry::handle(it.key())] = color;
+  }
+
+  // colors resolved with the previous configuration are stale now
+  _typeColors.clear();
 }
 
 
@@ -162,6 +198,52 @@ normalColor() const
 QColor
 ConnectionStyle::
 normalColor(QString typeId) const
+{
+  return normalColor(DataTypeRegistry::handle(typeId));
+}
+
+
+QColor const&
+ConnectionStyle::
+normalColor(TypeHandle typeHandle) const
+{
+  if (typeHandle == QtNodes::InvalidTypeHandle)
+    return NormalColor;
+
+  if (typeHandle >= _typeColors.size())
+    resolveTypeColors(typeHandle);
+
+  return _typeColors[typeHandle];
+}
+
+
+void
+ConnectionStyle::
+resolveTypeColors(TypeHandle typeHandle) const
+{
+  std::size_t const first = _typeColors.size();
+  std::size_t const count = std::max<std::size_t>(DataTypeRegistry::size(),
+                                                  typeHandle + 1);
+
+  _typeColors.reserve(count);
+
+  for (std::size_t i = first; i < count; ++i)
+  {
+    auto const h = static_cast<TypeHandle>(i);
+
+    auto it = _typeColorOverrides.find(h);
+
+    if (it != _typeColorOverrides.end())
+      _typeColors.push_back(it->second);
+    else
+      _typeColors.push_back(generatedTypeColor(DataTypeRegistry::typeId(h)));
+  }
+}
+
+
+QColor
+ConnectionStyle::
+generatedTypeColor(QString const& typeId)
 {
   qint32 hash = qHash(typeId);
 
@@ -1,13 +1,32 @@
 #include "DataModelRegistry.hpp"
 
+#include <atomic>
+
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
 #include <QtWidgets/QMessageBox>
 
+#include "PluginLibrary.hpp"
+
 using QtNodes::DataModelRegistry;
+using QtNodes::ModelDescriptor;
 using QtNodes::NodeDataModel;
 using QtNodes::NodeDataType;
+using QtNodes::PluginLibrary;
+using QtNodes::DataTypeRegistry;
+using QtNodes::TypeHandle;
 using QtNodes::TypeConverter;
 
+DataModelRegistry::
+DataModelRegistry()
+  : _revision(nextRevision())
+{}
+
+
 std::unique_ptr<NodeDataModel>
 DataModelRegistry::
 create(QString const &modelName)
@@ -23,6 +42,116 @@ create(QString const &modelName)
 }
 
 
+void
+DataModelRegistry::
+registerModel(ModelDescriptor descriptor,
+              RegistryItemCreator creator)
+{
+  QString const name = descriptor.name;
+
+  if (name.isEmpty() || _registeredItemCreators.count(name))
+    return;
+
+  if (descriptor.caption.isEmpty())
+    descriptor.caption = name;
+
+  if (descriptor.category.isEmpty())
+    descriptor.category = QStringLiteral("Nodes");
+
+  // interning the port types gives them their handles before anything is
+  // painted
+  for (auto const & type : descriptor.inputs)
+    type.handle();
+
+  for (auto const & type : descriptor.outputs)
+    type.handle();
+
+  _registeredItemCreators[name] = std::move(creator);
+  _categories.insert(descriptor.category);
+  _registeredModelsCategory[name] = descriptor.category;
+  _registeredModelDescriptors.emplace(name, std::move(descriptor));
+  _revision = nextRevision();
+}
+
+
+bool
+DataModelRegistry::
+registerPlugin(QString const &manifestFile)
+{
+  QFile file(manifestFile);
+
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    qWarning() << "Couldn't open plugin manifest" << manifestFile;
+
+    return false;
+  }
+
+  QJsonDocument const document = QJsonDocument::fromJson(file.readAll());
+
+  if (!document.isObject())
+  {
+    qWarning() << "Invalid plugin manifest" << manifestFile;
+
+    return false;
+  }
+
+  return registerPlugin(document.object(),
+                        QFileInfo(manifestFile).absolutePath());
+}
+
+
+bool
+DataModelRegistry::
+registerPlugin(QJsonObject const &manifest,
+               QString const &directory)
+{
+  QString const libraryName = manifest["library"].toString();
+
+  if (libraryName.isEmpty())
+    return false;
+
+  auto library =
+    std::make_shared<PluginLibrary>(QDir(directory).filePath(libraryName));
+
+  auto portTypes = [](QJsonValue const &ports)
+  {
+    std::vector<NodeDataType> types;
+
+    for (QJsonValue const port : ports.toArray())
+    {
+      QJsonObject const object = port.toObject();
+
+      types.push_back(NodeDataType{object["id"].toString(),
+                                   object["name"].toString()});
+    }
+
+    return types;
+  };
+
+  for (QJsonValue const value : manifest["models"].toArray())
+  {
+    QJsonObject const model = value.toObject();
+
+    ModelDescriptor descriptor;
+    descriptor.name     = model["name"].toString();
+    descriptor.category = model["category"].toString();
+    descriptor.caption  = model["caption"].toString();
+    descriptor.inputs   = portTypes(model["inputs"]);
+    descriptor.outputs  = portTypes(model["outputs"]);
+
+    QString const name = descriptor.name;
+
+    registerModel(std::move(descriptor), [library, name]()
+    {
+      return library->create(name);
+    });
+  }
+
+  return true;
+}
+
+
 DataModelRegistry::RegisteredModelCreatorsMap const &
 DataModelRegistry::
 registeredModelCreators() const
@@ -47,14 +176,33 @@ categories() const
 }
 
 
+DataModelRegistry::RegisteredModelDescriptorsMap const &
+DataModelRegistry::
+registeredModelDescriptors() const
+{
+  return _registeredModelDescriptors;
+}
+
+
+ModelDescriptor const *
+DataModelRegistry::
+descriptor(QString const &modelName) const
+{
+  auto it = _registeredModelDescriptors.find(modelName);
+
+  if (it != _registeredModelDescriptors.end())
+    return &it->second;
+
+  return nullptr;
+}
+
+
 TypeConverter
 DataModelRegistry::
 getTypeConverter(NodeDataType const & d1,
                  NodeDataType const & d2) const
 {
-  TypeConverterId converterId = std::make_pair(d1, d2);
-
-  auto it = _registeredTypeConverters.find(converterId);
+  auto it = _registeredTypeConverters.find(converterKey(d1, d2));
 
   if (it != _registeredTypeConverters.end())
   {
@@ -63,3 +211,29 @@ getTypeConverter(NodeDataType const & d1,
 
   return TypeConverter{};
 }
+
+
+void
+DataModelRegistry::
+setCompatible(TypeHandle from, TypeHandle to)
+{
+  if (from >= _converterTargets.size())
+    _converterTargets.resize(from + 1);
+
+  auto & targets = _converterTargets[from];
+
+  auto it = std::lower_bound(targets.begin(), targets.end(), to);
+
+  if (it == targets.end() || *it != to)
+    targets.insert(it, to);
+}
+
+
+quint64
+DataModelRegistry::
+nextRevision()
+{
+  static std::atomic<quint64> revision{0};
+
+  return ++revision;
+}
@@ -0,0 +1,64 @@
+#include "DataTypeRegistry.hpp"
+
+#include <QtCore/QMutexLocker>
+
+using QtNodes::DataTypeRegistry;
+using QtNodes::TypeHandle;
+
+TypeHandle
+DataTypeRegistry::
+handle(QString const& typeId)
+{
+  auto & registry = instance();
+
+  QMutexLocker locker(&registry._mutex);
+
+  auto it = registry._handles.find(typeId);
+
+  if (it != registry._handles.end())
+    return it->second;
+
+  TypeHandle const handle = static_cast<TypeHandle>(registry._typeIds.size());
+
+  registry._typeIds.push_back(typeId);
+  registry._handles.emplace(typeId, handle);
+
+  return handle;
+}
+
+
+QString
+DataTypeRegistry::
+typeId(TypeHandle handle)
+{
+  auto & registry = instance();
+
+  QMutexLocker locker(&registry._mutex);
+
+  if (handle >= registry._typeIds.size())
+    return QString();
+
+  return registry._typeIds[handle];
+}
+
+
+std::size_t
+DataTypeRegistry::
+size()
+{
+  auto & registry = instance();
+
+  QMutexLocker locker(&registry._mutex);
+
+  return registry._typeIds.size();
+}
+
+
+DataTypeRegistry&
+DataTypeRegistry::
+instance()
+{
+  static DataTypeRegistry registry;
+
+  return registry;
+}
@@ -0,0 +1,372 @@
+#include "DiskResultCache.hpp"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+
+using QtNodes::DiskResultCache;
+using QtNodes::NodeData;
+using QtNodes::NodeDataType;
+
+namespace
+{
+
+quint32 const fileMagic   = 0x514e5243; // "QNRC"
+quint32 const fileVersion = 1;
+
+QString const fileSuffix = QStringLiteral(".result");
+}
+
+
+DiskResultCache::
+DiskResultCache(QString const& directory,
+                qint64 maxSize)
+  : _directory(directory)
+  , _maxSize(maxSize)
+{
+  _directory.mkpath(QStringLiteral("."));
+
+  // entries left by previous sessions, least recently used first
+  QFileInfoList const files =
+    _directory.entryInfoList({QStringLiteral("*") + fileSuffix},
+                             QDir::Files,
+                             QDir::Time | QDir::Reversed);
+
+  for (QFileInfo const& file : files)
+    touch(file.completeBaseName().toLatin1(), file.size());
+
+  evict(_maxSize);
+}
+
+
+QString
+DiskResultCache::
+directory() const
+{
+  return _directory.absolutePath();
+}
+
+
+void
+DiskResultCache::
+registerDeserializer(NodeDataType const& type,
+                     Deserializer deserializer)
+{
+  _deserializers[type.id] = std::move(deserializer);
+}
+
+
+QByteArray
+DiskResultCache::
+makeKey(QByteArray const& state,
+        std::vector<std::shared_ptr<NodeData>> const& inputs)
+{
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+
+  hash.addData(state);
+
+  for (auto const& input : inputs)
+  {
+    quint64 contentHash = 0;
+
+    if (input)
+    {
+      contentHash = input->contentHash();
+
+      if (contentHash == 0)
+        return QByteArray();
+
+      hash.addData(input->type().id.toUtf8());
+    }
+
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream << bool(input) << contentHash;
+
+    hash.addData(bytes);
+  }
+
+  return hash.result().toHex();
+}
+
+
+bool
+DiskResultCache::
+load(QByteArray const& key, Outputs & outputs)
+{
+  auto it = _entries.find(key);
+
+  if (it == _entries.end())
+  {
+    ++_stats.misses;
+
+    return false;
+  }
+
+  QFile file(filePath(key));
+
+  if (!file.open(QIODevice::ReadOnly) || !decode(file.readAll(), outputs))
+  {
+    // removed or corrupted behind our back
+    remove(key);
+
+    ++_stats.misses;
+
+    return false;
+  }
+
+  file.close();
+  file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+  touch(key, it->second.size);
+
+  ++_stats.hits;
+
+  return true;
+}
+
+
+bool
+DiskResultCache::
+store(QByteArray const& key, Outputs const& outputs)
+{
+  QByteArray bytes;
+
+  if (key.isEmpty() || !encode(outputs, bytes) || bytes.size() > _maxSize)
+    return false;
+
+  QSaveFile file(filePath(key));
+
+  if (!file.open(QIODevice::WriteOnly) ||
+      file.write(bytes) != bytes.size() ||
+      !file.commit())
+  {
+    qWarning() << "Couldn't write result cache entry" << file.fileName();
+
+    return false;
+  }
+
+  touch(key, bytes.size());
+
+  ++_stats.writes;
+
+  evict(_maxSize);
+
+  return true;
+}
+
+
+bool
+DiskResultCache::
+verify(QByteArray const& key, Outputs const& outputs)
+{
+  QByteArray bytes;
+
+  if (key.isEmpty() || !encode(outputs, bytes))
+    return true;
+
+  QFile file(filePath(key));
+
+  if (_entries.count(key) == 0 || !file.open(QIODevice::ReadOnly))
+  {
+    store(key, outputs);
+
+    return true;
+  }
+
+  ++_stats.verified;
+
+  if (file.readAll() == bytes)
+    return true;
+
+  ++_stats.verifyFailures;
+
+  qWarning() << "Result cache entry" << file.fileName()
+             << "differs from the recomputed outputs";
+
+  return false;
+}
+
+
+void
+DiskResultCache::
+setMaxSize(qint64 bytes)
+{
+  _maxSize = bytes;
+
+  evict(_maxSize);
+}
+
+
+void
+DiskResultCache::
+clear()
+{
+  while (!_useOrder.empty())
+  {
+    QByteArray const key = _useOrder.begin()->second;
+
+    remove(key);
+  }
+}
+
+
+DiskResultCache::Stats
+DiskResultCache::
+stats() const
+{
+  Stats stats = _stats;
+  stats.entries   = _entries.size();
+  stats.diskUsage = _diskUsage;
+
+  return stats;
+}
+
+
+QString
+DiskResultCache::
+filePath(QByteArray const& key) const
+{
+  return _directory.filePath(QString::fromLatin1(key) + fileSuffix);
+}
+
+
+bool
+DiskResultCache::
+encode(Outputs const& outputs, QByteArray & bytes)
+{
+  QDataStream stream(&bytes, QIODevice::WriteOnly);
+
+  stream << fileMagic << fileVersion << quint32(outputs.size());
+
+  for (auto const& output : outputs)
+  {
+    if (!output)
+    {
+      stream << QString();
+      continue;
+    }
+
+    QByteArray payload;
+    QDataStream payloadStream(&payload, QIODevice::WriteOnly);
+
+    if (!output->serialize(payloadStream))
+      return false;
+
+    stream << output->type().id << payload;
+  }
+
+  return stream.status() == QDataStream::Ok;
+}
+
+
+bool
+DiskResultCache::
+decode(QByteArray const& bytes, Outputs & outputs) const
+{
+  QDataStream stream(bytes);
+
+  quint32 magic = 0;
+  quint32 version = 0;
+  quint32 count = 0;
+
+  stream >> magic >> version >> count;
+
+  if (magic != fileMagic || version != fileVersion)
+    return false;
+
+  Outputs decoded;
+
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+  {
+    QString typeId;
+    stream >> typeId;
+
+    if (typeId.isEmpty())
+    {
+      decoded.push_back(nullptr);
+      continue;
+    }
+
+    auto it = _deserializers.find(typeId);
+
+    if (it == _deserializers.end())
+      return false;
+
+    QByteArray payload;
+    stream >> payload;
+
+    QDataStream payloadStream(payload);
+
+    auto data = it->second(payloadStream);
+
+    if (!data)
+      return false;
+
+    decoded.push_back(std::move(data));
+  }
+
+  if (stream.status() != QDataStream::Ok || decoded.size() != count)
+    return false;
+
+  outputs = std::move(decoded);
+
+  return true;
+}
+
+
+void
+DiskResultCache::
+touch(QByteArray const& key, qint64 size)
+{
+  auto it = _entries.find(key);
+
+  if (it != _entries.end())
+  {
+    _useOrder.erase(it->second.lastUse);
+    _diskUsage -= it->second.size;
+  }
+
+  quint64 const use = ++_useCounter;
+
+  _entries[key] = Entry{size, use};
+  _useOrder.emplace(use, key);
+
+  _diskUsage += size;
+}
+
+
+void
+DiskResultCache::
+remove(QByteArray const& key)
+{
+  auto it = _entries.find(key);
+
+  if (it == _entries.end())
+    return;
+
+  QFile::remove(filePath(key));
+
+  _diskUsage -= it->second.size;
+  _useOrder.erase(it->second.lastUse);
+  _entries.erase(it);
+}
+
+
+void
+DiskResultCache::
+evict(qint64 maxSize)
+{
+  while (_diskUsage > maxSize && !_useOrder.empty())
+  {
+    QByteArray const key = _useOrder.begin()->second;
+
+    remove(key);
+
+    ++_stats.evictions;
+  }
+}
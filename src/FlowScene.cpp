@@ -1,5 +1,6 @@
 #include "FlowScene.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <utility>
 #include <unordered_set>
@@ -17,6 +18,8 @@
 #include <QtCore/QJsonArray>
 #include <QtCore/QtGlobal>
 #include <QtCore/QDebug>
+#include <QtCore/QTimer>
+#include <QtWidgets/QGraphicsView>
 #include <QDir>
 
 #include "Node.hpp"
@@ -30,7 +33,10 @@
 
 #include "FlowView.hpp"
 #include "DataModelRegistry.hpp"
+#include "AsyncNodeDataModel.hpp"
+#include "SpatialGrid.hpp"
 
+using QtNodes::AsyncNodeDataModel;
 using QtNodes::FlowScene;
 using QtNodes::Node;
 using QtNodes::NodeGraphicsObject;
@@ -42,12 +48,15 @@ using QtNodes::PortIndex;
 using QtNodes::TypeConverter;
 using QtNodes::NodeGroup;
 using QtNodes::GroupGraphicsObject;
+using QtNodes::IdGenerator;
+using QtNodes::SpatialGrid;
 
 FlowScene::
 FlowScene(std::shared_ptr<DataModelRegistry> registry,
           QObject * parent)
   : QGraphicsScene(parent)
   , _registry(std::move(registry))
+  , _spatialIndex(detail::make_unique<SpatialGrid>(_spatialCellSize))
 {
   setItemIndexMethod(QGraphicsScene::NoIndex);
 
@@ -60,10 +69,82 @@ FlowScene(std::shared_ptr<DataModelRegistry> registry,
                           std::numeric_limits<int>::max())};
   setSceneRect(maximumRect);
 
-  // This connection should come first
-  connect(this, &FlowScene::connectionCreated, this, &FlowScene::setupConnectionSignals);
+  // connections report their changes through the scene, which forwards them
+  // as signals; a partial connection is only created once it's completed
+  _connectionEvents = std::make_shared<ConnectionEvents>();
+  _connectionEvents->completed.emplace_back([this](Connection const& c)
+  {
+    connectionCompleted(c);
+    connectionCreated(c);
+  });
+  _connectionEvents->madeIncomplete.emplace_back([this](Connection const& c)
+  {
+    connectionMadeIncomplete(c);
+    connectionDeleted(c);
+  });
+  _connectionEvents->updated.emplace_back([this](Connection const& c)
+  {
+    connectionUpdated(c);
+  });
+  _connectionEvents->throttled.emplace_back([this](Connection const& c)
+  {
+    _throttledConnections.insert(c.id());
+    schedulePropagation();
+  });
+
   connect(this, &FlowScene::connectionCreated, this, &FlowScene::sendConnectionCreatedToNodes);
   connect(this, &FlowScene::connectionDeleted, this, &FlowScene::sendConnectionDeletedToNodes);
+
+  // items moved or created out of view may have to be parked, and vice versa
+  connect(this, &FlowScene::nodeCreated, this, [this](Node& n)
+  {
+    if (n.nodeDataModel()->embeddedWidgetDeferred())
+      _nodesAwaitingWidget.insert(&n);
+
+    invalidateBounds(n);
+    scheduleVisibleAreaUpdate();
+  });
+  connect(this, &FlowScene::connectionCreated, this, [this](Connection const& c)
+  {
+    invalidateBounds(&c.getConnectionGraphicsObject());
+    scheduleVisibleAreaUpdate();
+  });
+  connect(this, &FlowScene::connectionDeleted, this, [this](Connection const& c)
+  {
+    // a connection made incomplete is being dragged, and never parked
+    dropBounds(&c.getConnectionGraphicsObject());
+  });
+
+  // collect the changes of the frame in a single change set
+  connect(this, &FlowScene::nodeCreated, this, [this](Node& n)
+  {
+    _changes.nodeCreated(n.id());
+    scheduleChanges();
+
+    if (auto* model = qobject_cast<AsyncNodeDataModel*>(n.nodeDataModel()))
+      model->setScheduler(_computeScheduler);
+
+    connect(n.nodeDataModel(), &NodeDataModel::dataUpdated, this, [this, &n]
+    {
+      _changes.nodeUpdated(n.id());
+      scheduleChanges();
+    });
+  });
+  connect(this, &FlowScene::nodeDeleted, this, [this](Node& n)
+  {
+    _changes.nodeDeleted(n.id());
+    scheduleChanges();
+  });
+  connect(this, &FlowScene::connectionCreated, this, [this](Connection const& c)
+  {
+    _changes.connectionCreated(c.id());
+    scheduleChanges();
+  });
+  connect(this, &FlowScene::connectionDeleted, this, [this](Connection const& c)
+  {
+    _changes.connectionDeleted(c.id());
+    scheduleChanges();
+  });
 }
 
 FlowScene::
@@ -89,6 +170,7 @@ createConnection(PortType connectedPort,
                  PortIndex portIndex)
 {
   auto connection = std::make_shared<Connection>(connectedPort, node, portIndex);
+  connection->_events = _connectionEvents;
 
   auto cgo = detail::make_unique<ConnectionGraphicsObject>(*this, *connection);
 
@@ -98,15 +180,8 @@ createConnection(PortType connectedPort,
   _connections[connection->id()] = connection;
 
   // Note: this connection isn't truly created yet. It's only partially created.
-  // Thus, don't send the connectionCreated(...) signal.
-
-  connect(connection.get(),
-          &Connection::connectionCompleted,
-          this,
-          [this](Connection const& c)
-  {
-    connectionCreated(c);
-  });
+  // Thus, don't send the connectionCreated(...) signal. The scene's
+  // ConnectionEvents handlers send it once the connection is completed.
 
   return connection;
 }
@@ -126,6 +201,7 @@ createConnection(Node& nodeIn,
                                  nodeOut,
                                  portIndexOut,
                                  converter);
+  connection->_events = _connectionEvents;
 
   auto cgo = detail::make_unique<ConnectionGraphicsObject>(*this, *connection);
 
@@ -169,30 +245,55 @@ loadConnectionToMap(const QJsonObject& connectionJson,
     nodeOutId = IDMap.at(nodeOutId);
   }
 
-  PortIndex portIndexIn  = connectionJson["in_index"].toInt();
-  PortIndex portIndexOut = connectionJson["out_index"].toInt();
-
   auto nodeIn  = nodesMap.at(nodeInId).get();
   auto nodeOut = nodesMap.at(nodeOutId).get();
 
+  return loadConnection(connectionJson, *nodeIn, *nodeOut, connectionsMap);
+}
+
+
+std::shared_ptr<Connection>
+FlowScene::
+restoreConnection(QJsonObject const& connectionJson,
+                  NodeRemap const& remap)
+{
+  Node* nodeIn  = remap.at(QUuid(connectionJson["in_id"].toString()));
+  Node* nodeOut = remap.at(QUuid(connectionJson["out_id"].toString()));
+
+  return loadConnection(connectionJson, *nodeIn, *nodeOut, _connections);
+}
+
+
+std::shared_ptr<Connection>
+FlowScene::
+loadConnection(QJsonObject const& connectionJson,
+               Node& nodeIn,
+               Node& nodeOut,
+               std::unordered_map<QUuid, std::shared_ptr<Connection>>& connectionsMap)
+{
+  PortIndex portIndexIn  = connectionJson["in_index"].toInt();
+  PortIndex portIndexOut = connectionJson["out_index"].toInt();
+
   const TypeConverter& converter = getConverter(connectionJson);
 
   auto connection =
-    std::make_shared<Connection>(*nodeIn,
+    std::make_shared<Connection>(nodeIn,
                                  portIndexIn,
-                                 *nodeOut,
+                                 nodeOut,
                                  portIndexOut,
                                  converter);
+  connection->_events = _connectionEvents;
+
   auto cgo = detail::make_unique<ConnectionGraphicsObject>(*this, *connection);
 
-  nodeIn->nodeState().setConnection(PortType::In, portIndexIn, *connection);
-  nodeOut->nodeState().setConnection(PortType::Out, portIndexOut, *connection);
+  nodeIn.nodeState().setConnection(PortType::In, portIndexIn, *connection);
+  nodeOut.nodeState().setConnection(PortType::Out, portIndexOut, *connection);
 
   // after this function connection points are set to node port
   connection->setGraphicsObject(std::move(cgo));
 
   // trigger data propagation
-  nodeOut->onDataUpdated(portIndexOut);
+  nodeOut.onDataUpdated(portIndexOut);
 
   connectionsMap[connection->id()] = connection;
 
@@ -208,6 +309,7 @@ deleteConnection(Connection& connection)
   if (it != _connections.end())
   {
     connection.removeFromNodes();
+    dropBounds(&connection.getConnectionGraphicsObject());
     _connections.erase(it);
   }
 }
@@ -320,6 +422,9 @@ removeNode(Node& node)
     removeNodeFromGroup(node.id());
   }
 
+  dropBounds(&node.nodeGraphicsObject());
+  _nodesAwaitingWidget.erase(&node);
+
   _nodes.erase(node.id());
 }
 
@@ -341,7 +446,10 @@ createGroup(std::vector<Node*>& nodes, QString groupName)
   {
     groupName = "Group " + QString::number(NodeGroup::groupCount());
   }
-  auto group = std::make_shared<NodeGroup>(nodes, QUuid::createUuid(), groupName, this);
+  auto group = std::make_shared<NodeGroup>(nodes,
+                                            IdGenerator::uuid(IdGenerator::next()),
+                                            groupName,
+                                            this);
   auto ggo   = std::make_unique<GroupGraphicsObject>(*this, *group);
 
   group->setGraphicsObject(std::move(ggo));
@@ -392,30 +500,42 @@ connectionsWithinGroup(const QUuid& groupID)
 std::pair<std::weak_ptr<NodeGroup>,std::unordered_map<QUuid,QUuid> >
 FlowScene::
 restoreGroup(QJsonObject const& groupJson)
+{
+  auto restored = restoreGroupItems(groupJson);
+
+  applyRestoredFreezes(restored.second);
+
+  return std::make_pair(restored.first, publicIdMap(restored.second));
+}
+
+
+std::pair<std::weak_ptr<NodeGroup>, FlowScene::NodeRemap>
+FlowScene::
+restoreGroupItems(QJsonObject const& groupJson)
 {
   // since the new nodes will have the same IDs as in the file and the connections
   // need these old IDs to be restored, we must create new IDs and map them to the
   // old ones so the connections are properly restored
-  std::unordered_map<QUuid, QUuid> IDsMap{};
+  QJsonArray nodesJson = groupJson["nodes"].toArray();
 
-  std::vector<Node*> group_children{};
+  NodeRemap IDsMap{};
+  IDsMap.reserve(nodesJson.size());
 
-  QJsonArray nodesJson = groupJson["nodes"].toArray();
+  std::vector<Node*> group_children{};
+  group_children.reserve(nodesJson.size());
   for (const QJsonValueRef nodeJson : nodesJson)
   {
     auto oldID = QUuid(nodeJson.toObject()["id"].toString());
     auto& nodeRef = loadNodeToMap(nodeJson.toObject(), _nodes, false);
 
-    auto newID = nodeRef.id();
-
-    IDsMap.insert(std::make_pair(oldID, newID));
+    IDsMap.insert(std::make_pair(oldID, &nodeRef));
     group_children.push_back(&nodeRef);
   }
 
   QJsonArray connectionJsonArray = groupJson["connections"].toArray();
   for (auto connection : connectionJsonArray)
   {
-    loadConnectionToMap(connection.toObject(), _nodes, _connections, IDsMap);
+    restoreConnection(connection.toObject(), IDsMap);
   }
 
   return std::make_pair(
@@ -473,6 +593,14 @@ registry() const
 }
 
 
+QtNodes::ComputeScheduler&
+FlowScene::
+computeScheduler() const
+{
+  return *_computeScheduler;
+}
+
+
 void
 FlowScene::
 setRegistry(std::shared_ptr<DataModelRegistry> registry)
@@ -603,6 +731,486 @@ getNodeSize(const Node& node) const
 }
 
 
+void
+FlowScene::
+setVirtualized(bool enabled)
+{
+  if (_virtualized == enabled)
+    return;
+
+  _virtualized = enabled;
+
+  if (_virtualized)
+  {
+    for (auto const& node : _nodes)
+      invalidateBounds(*node.second);
+
+    scheduleVisibleAreaUpdate();
+  }
+  else
+  {
+    for (QGraphicsItem* item : allGraphicsItems())
+      setItemAttached(item, true);
+
+    _spatialIndex->clear();
+    _boundsDirtyItems.clear();
+    _shownItems.clear();
+  }
+}
+
+
+bool
+FlowScene::
+isVirtualized() const
+{
+  return _virtualized;
+}
+
+
+void
+FlowScene::
+scheduleVisibleAreaUpdate()
+{
+  if ((!_virtualized && _nodesAwaitingWidget.empty()) || _visibleAreaUpdatePending)
+    return;
+
+  _visibleAreaUpdatePending = true;
+
+  QTimer::singleShot(0, this, &FlowScene::updateVisibleItems);
+}
+
+
+void
+FlowScene::
+setWidgetSnapshotsEnabled(bool enabled)
+{
+  if (_widgetSnapshotsEnabled == enabled)
+    return;
+
+  _widgetSnapshotsEnabled = enabled;
+
+  for (auto const& node : _nodes)
+    node.second->nodeGraphicsObject().setWidgetLive(!enabled);
+}
+
+
+bool
+FlowScene::
+widgetSnapshotsEnabled() const
+{
+  return _widgetSnapshotsEnabled;
+}
+
+
+void
+FlowScene::
+queueNodeDrag(QPointF const& offset)
+{
+  _pendingDragOffset += offset;
+
+  if (_nodeDragPending)
+    return;
+
+  _nodeDragPending = true;
+
+  QTimer::singleShot(_dragFrameInterval, this, &FlowScene::flushNodeDrag);
+}
+
+
+void
+FlowScene::
+flushNodeDrag()
+{
+  if (!_nodeDragPending)
+    return;
+
+  _nodeDragPending = false;
+
+  QPointF const offset = _pendingDragOffset;
+  _pendingDragOffset = QPointF();
+
+  if (offset.isNull())
+    return;
+
+  // as in QGraphicsItem::mouseMoveEvent(), an unselected grabber moves alone
+  auto grabber = qgraphicsitem_cast<NodeGraphicsObject*>(mouseGrabberItem());
+
+  QList<QGraphicsItem*> items = selectedItems();
+  if (grabber && !grabber->isSelected())
+    items = { grabber };
+
+  QRectF const grabberRect = grabber ? grabber->sceneBoundingRect() : QRectF();
+
+  std::vector<Node*> movedNodes;
+  std::unordered_set<Connection*> movedConnections;
+  QRectF movedArea;
+
+  for (QGraphicsItem* item : items)
+  {
+    if (!(item->flags() & QGraphicsItem::ItemIsMovable))
+      continue;
+
+    auto ngo = qgraphicsitem_cast<NodeGraphicsObject*>(item);
+
+    if (!ngo)
+    {
+      item->moveBy(offset.x(), offset.y());
+      continue;
+    }
+
+    ngo->moveBatched(offset);
+
+    Node& node = ngo->node();
+
+    movedNodes.push_back(&node);
+    movedArea |= ngo->sceneBoundingRect();
+
+    for (PortType portType : { PortType::In, PortType::Out })
+    {
+      for (auto const& connections : node.nodeState().getEntries(portType))
+      {
+        for (auto const& connection : connections)
+          movedConnections.insert(connection.second);
+      }
+    }
+  }
+
+  // connections between two moved nodes are only recomputed once
+  for (Connection* connection : movedConnections)
+    connection->getConnectionGraphicsObject().move();
+
+  for (Node* node : movedNodes)
+    node->nodeGraphicsObject().updateGroupBounds();
+
+  if (grabber)
+    grabber->updateGroupHover(grabberRect);
+
+  setSceneRect(sceneRect().united(movedArea));
+
+  if (!movedNodes.empty())
+    notifyNodesMoved(movedNodes);
+}
+
+
+void
+FlowScene::
+notifyNodeMoved(Node& node, QPointF const& newLocation)
+{
+  _changes.nodeMoved(node.id(), newLocation);
+  scheduleChanges();
+  invalidateBounds(node);
+  scheduleVisibleAreaUpdate();
+
+  if (_nodeMovedSignalsEnabled)
+    nodeMoved(node, newLocation);
+}
+
+
+void
+FlowScene::
+notifyNodesMoved(std::vector<Node*> const& nodes)
+{
+  for (Node* node : nodes)
+  {
+    _changes.nodeMoved(node->id(), node->nodeGraphicsObject().pos());
+    invalidateBounds(*node);
+  }
+
+  scheduleChanges();
+  scheduleVisibleAreaUpdate();
+
+  nodesMoved(nodes);
+}
+
+
+void
+FlowScene::
+notifyNodeResized(Node& node)
+{
+  invalidateBounds(node);
+  scheduleVisibleAreaUpdate();
+}
+
+
+void
+FlowScene::
+setNodeMovedSignalsEnabled(bool enabled)
+{
+  _nodeMovedSignalsEnabled = enabled;
+}
+
+
+bool
+FlowScene::
+nodeMovedSignalsEnabled() const
+{
+  return _nodeMovedSignalsEnabled;
+}
+
+
+void
+FlowScene::
+scheduleChanges()
+{
+  if (_changesPending)
+    return;
+
+  _changesPending = true;
+
+  QTimer::singleShot(_changeSetInterval, this, &FlowScene::flushChanges);
+}
+
+
+void
+FlowScene::
+schedulePropagation()
+{
+  if (_propagationPending)
+    return;
+
+  _propagationPending = true;
+
+  QTimer::singleShot(_propagationInterval, this, &FlowScene::flushPropagation);
+}
+
+
+void
+FlowScene::
+flushPropagation()
+{
+  _propagationPending = false;
+
+  // deliveries may hold values back again, which adds them to the new set
+  std::unordered_set<QUuid> connections;
+  connections.swap(_throttledConnections);
+
+  for (auto const& id : connections)
+  {
+    auto it = _connections.find(id);
+
+    if (it != _connections.end() && it->second->flushPropagation())
+      _throttledConnections.insert(id);
+  }
+
+  if (!_throttledConnections.empty())
+    schedulePropagation();
+}
+
+
+void
+FlowScene::
+flushChanges()
+{
+  _changesPending = false;
+
+  if (_changes.empty())
+    return;
+
+  changesCommitted(_changes.take());
+}
+
+
+QRectF
+FlowScene::
+contentsBoundingRect() const
+{
+  if (!_virtualized)
+    return itemsBoundingRect();
+
+  QRectF rect;
+
+  for (QGraphicsItem const* item : allGraphicsItems())
+    rect |= item->sceneBoundingRect();
+
+  return rect;
+}
+
+
+QList<QGraphicsItem*>
+FlowScene::
+allGraphicsItems() const
+{
+  QList<QGraphicsItem*> result;
+  result.reserve(static_cast<int>(_groups.size() + _nodes.size() + _connections.size()));
+
+  for (auto const& group : _groups)
+    result.append(&group.second->groupGraphicsObject());
+
+  for (auto const& node : _nodes)
+    result.append(&node.second->nodeGraphicsObject());
+
+  for (auto const& connection : _connections)
+    result.append(&connection.second->getConnectionGraphicsObject());
+
+  return result;
+}
+
+
+void
+FlowScene::
+updateVisibleItems()
+{
+  _visibleAreaUpdatePending = false;
+
+  if (!_virtualized && _nodesAwaitingWidget.empty())
+    return;
+
+  std::vector<QRectF> visibleAreas;
+
+  for (QGraphicsView* view : views())
+  {
+    if (!view->isVisible())
+      continue;
+
+    QRectF area = view->mapToScene(view->viewport()->rect()).boundingRect();
+
+    double const scale  = view->transform().m11();
+    double const margin = scale > 0.0 ? _virtualizationMargin / scale : 0.0;
+
+    visibleAreas.push_back(area.adjusted(-margin, -margin, margin, margin));
+  }
+
+  // without a visible view there is nothing to decide on; keep what we have
+  if (visibleAreas.empty())
+    return;
+
+  if (!_virtualized)
+  {
+    for (QRectF const& area : visibleAreas)
+    {
+      for (QGraphicsItem* item : items(area))
+        requestDeferredWidget(item);
+    }
+
+    return;
+  }
+
+  // only the items that moved since the last pass are measured again
+  std::unordered_set<QGraphicsItem*> carried;
+
+  for (QGraphicsItem* item : _boundsDirtyItems)
+  {
+    // items carried by a dragged group stay with it until it is dropped
+    if (item->parentItem())
+      carried.insert(item);
+    else
+      _spatialIndex->insert(item, item->sceneBoundingRect());
+  }
+
+  std::unordered_set<QGraphicsItem*> visible;
+
+  for (QRectF const& area : visibleAreas)
+    _spatialIndex->query(area, visible);
+
+  for (QGraphicsItem* item : selectedItems())
+    visible.insert(item);
+
+  if (QGraphicsItem* grabber = mouseGrabberItem())
+    visible.insert(grabber);
+
+  // attached items that may have left the views: the ones shown by the last
+  // pass, and the ones moved or created since
+  for (auto const* candidates : { &_shownItems, &_boundsDirtyItems })
+  {
+    for (QGraphicsItem* item : *candidates)
+    {
+      if (!visible.count(item) && !carried.count(item))
+        setItemAttached(item, false);
+    }
+  }
+
+  for (QGraphicsItem* item : visible)
+  {
+    if (!item->parentItem())
+      setItemAttached(item, true);
+
+    requestDeferredWidget(item);
+  }
+
+  _boundsDirtyItems = std::move(carried);
+  _shownItems = std::move(visible);
+}
+
+
+void
+FlowScene::
+requestDeferredWidget(QGraphicsItem* item)
+{
+  if (_nodesAwaitingWidget.empty())
+    return;
+
+  auto ngo = qgraphicsitem_cast<NodeGraphicsObject*>(item);
+
+  if (ngo && _nodesAwaitingWidget.erase(&ngo->node()))
+    ngo->requestDeferredWidget();
+}
+
+
+void
+FlowScene::
+invalidateBounds(Node& node)
+{
+  if (!_virtualized)
+    return;
+
+  invalidateBounds(&node.nodeGraphicsObject());
+
+  for (PortType portType : { PortType::In, PortType::Out })
+  {
+    for (auto const& connections : node.nodeState().getEntries(portType))
+    {
+      for (auto const& connection : connections)
+        invalidateBounds(&connection.second->getConnectionGraphicsObject());
+    }
+  }
+}
+
+
+void
+FlowScene::
+invalidateBounds(QGraphicsItem* item)
+{
+  if (_virtualized)
+    _boundsDirtyItems.insert(item);
+}
+
+
+void
+FlowScene::
+dropBounds(QGraphicsItem* item)
+{
+  _spatialIndex->remove(item);
+  _boundsDirtyItems.erase(item);
+  _shownItems.erase(item);
+}
+
+
+void
+FlowScene::
+setItemAttached(QGraphicsItem* item, bool attached)
+{
+  if ((item->scene() == this) == attached)
+    return;
+
+  auto ngo = qgraphicsitem_cast<NodeGraphicsObject*>(item);
+
+  if (attached)
+  {
+    addItem(item);
+
+    if (ngo)
+      ngo->setParked(false);
+  }
+  else
+  {
+    if (ngo)
+      ngo->setParked(true);
+
+    removeItem(item);
+  }
+}
+
+
 std::unordered_map<QUuid, std::unique_ptr<Node> > const &
 FlowScene::
 nodes() const
@@ -755,7 +1363,8 @@ QByteArray
 FlowScene::
 saveToMemory() const
 {
-  return saveItems(items());
+  // parked items aren't part of the QGraphicsScene
+  return saveItems(_virtualized ? allGraphicsItems() : items());
 }
 
 
@@ -841,19 +1450,44 @@ std::unordered_map<QUuid, QUuid>
 FlowScene::
 loadItems(const QByteArray& data, QPointF pastePos, bool usePastePos)
 {
-  QJsonObject const jsonDocument = QJsonDocument::fromJson(data).object();
+  return publicIdMap(restoreItems(data, pastePos, usePastePos));
+}
 
-  // maps the stored (old) node UIDs to their new assigned UIDs
+
+std::unordered_map<QUuid, QUuid>
+FlowScene::
+publicIdMap(NodeRemap const& remap)
+{
   std::unordered_map<QUuid, QUuid> IDMap{};
+  IDMap.reserve(remap.size());
+
+  for (auto const& ids : remap)
+    IDMap.emplace(ids.first, ids.second->id());
+
+  return IDMap;
+}
+
+
+FlowScene::NodeRemap
+FlowScene::
+restoreItems(QByteArray const& data, QPointF pastePos, bool usePastePos)
+{
+  QJsonObject const jsonDocument = QJsonDocument::fromJson(data).object();
+
+  QJsonArray groupsJsonArray = jsonDocument["groups"].toArray();
+  QJsonArray nodesJsonArray  = jsonDocument["nodes"].toArray();
+
+  // maps the stored (old) node UIDs to the nodes restored from them
+  NodeRemap IDMap{};
+  IDMap.reserve(nodesJsonArray.size());
 
   QPointF offset;
   bool offsetInitialized{false};
   clearSelection();
 
-  QJsonArray groupsJsonArray = jsonDocument["groups"].toArray();
   for (const auto& group: groupsJsonArray)
   {
-    auto [groupWeakPtr, groupIDsMap] = restoreGroup(group.toObject());
+    auto [groupWeakPtr, groupIDsMap] = restoreGroupItems(group.toObject());
     IDMap.merge(groupIDsMap);
     if (auto groupPtr = groupWeakPtr.lock(); groupPtr)
     {
@@ -871,15 +1505,13 @@ loadItems(const QByteArray& data, QPointF pastePos, bool usePastePos)
       ggoRef.setSelected(true);
     }
   }
-  QJsonArray nodesJsonArray = jsonDocument["nodes"].toArray();
   for (QJsonValueRef node : nodesJsonArray)
   {
     auto nodeObj = node.toObject();
     auto& nodeRef = restoreNode(nodeObj, false);
 
     QUuid oldID{nodeObj["id"].toString()};
-    QUuid newID{nodeRef.id()};
-    IDMap.insert(std::make_pair(oldID, newID));
+    IDMap.insert(std::make_pair(oldID, &nodeRef));
 
     auto& ngoRef = nodeRef.nodeGraphicsObject();
     if (usePastePos && !offsetInitialized)
@@ -898,16 +1530,28 @@ loadItems(const QByteArray& data, QPointF pastePos, bool usePastePos)
   QJsonArray connectionJsonArray = jsonDocument["connections"].toArray();
   for (QJsonValueRef connection : connectionJsonArray)
   {
-    auto connPtr = loadConnectionToMap(connection.toObject(), _nodes,
-                                       _connections, IDMap);
+    auto connPtr = restoreConnection(connection.toObject(), IDMap);
     if (connPtr)
     {
       connPtr->getConnectionGraphicsObject().setSelected(true);
     }
   }
+
+  // nodes are frozen once all their inputs are connected
+  applyRestoredFreezes(IDMap);
+
   return IDMap;
 }
 
+
+void
+FlowScene::
+applyRestoredFreezes(NodeRemap const& remap)
+{
+  for (auto const& ids : remap)
+    ids.second->applyRestoredFreeze();
+}
+
 bool
 FlowScene::
 checkCopyableSelection() const
@@ -1087,18 +1731,6 @@ eraseNodePort(const QUuid& nodeId,
 }
 
 
-void
-FlowScene::
-setupConnectionSignals(Connection const& c)
-{
-  connect(&c,
-          &Connection::connectionMadeIncomplete,
-          this,
-          &FlowScene::connectionDeleted,
-          Qt::UniqueConnection);
-}
-
-
 void
 FlowScene::
 sendConnectionCreatedToNodes(Connection const& c)
@@ -13,6 +13,7 @@
 #include <QtWidgets>
 
 #include <QDebug>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -26,6 +27,7 @@
 #include "GroupGraphicsObject.hpp"
 
 using QtNodes::FlowView;
+using QtNodes::DataModelRegistry;
 using QtNodes::FlowScene;
 using QtNodes::GroupGraphicsObject;
 using QtNodes::NodeGraphicsObject;
@@ -61,7 +63,9 @@ FlowView(QWidget *parent)
 
   setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
 
-  setCacheMode(QGraphicsView::CacheBackground);
+  // the grid is drawn from a cached tile, which is cheaper than
+  // re-rendering the background cache after every pan
+  setCacheMode(QGraphicsView::CacheNone);
 
   setAcceptDrops(true);
 
@@ -237,9 +241,22 @@ groupContextMenu(QContextMenuEvent* event,
   auto* saveGroupAction = new QAction(&groupMenu);
   saveGroupAction->setText(QStringLiteral("Save Group..."));
   groupMenu.addAction(saveGroupAction);
+
+  auto* freezeGroupAction = new QAction(&groupMenu);
+  freezeGroupAction->setText(QStringLiteral("Freeze Group"));
+  freezeGroupAction->setCheckable(true);
+  freezeGroupAction->setChecked(ggo->group().isFrozen());
+  groupMenu.addAction(freezeGroupAction);
+
   groupMenu.addAction(_copySelectionAction);
   groupMenu.addAction(_cutSelectionAction);
 
+  connect(freezeGroupAction, &QAction::toggled,
+          [&ggo](bool frozen)
+  {
+    ggo->group().setFrozen(frozen);
+  });
+
   connect(saveGroupAction, &QAction::triggered,
           [&ggo, &_scene = _scene]()
   {
@@ -308,6 +325,18 @@ nodeContextMenu(QContextMenuEvent* event,
 
     nodeMenu.addAction(_createGroupFromSelectionAction);
   }
+
+  auto* freezeAction = new QAction(&nodeMenu);
+  freezeAction->setText(QStringLiteral("Freeze"));
+  freezeAction->setCheckable(true);
+  freezeAction->setChecked(ngo->node().isFrozen());
+  nodeMenu.addAction(freezeAction);
+
+  connect(freezeAction, &QAction::toggled, [&ngo](bool frozen)
+  {
+    ngo->node().setFrozen(frozen);
+  });
+
   nodeMenu.addAction(_copySelectionAction);
   nodeMenu.addAction(_cutSelectionAction);
   nodeMenu.exec(event->globalPos());
@@ -501,7 +530,7 @@ void
 FlowView::
 zoomFitAll()
 {
-  fitInView(_scene->itemsBoundingRect(), Qt::KeepAspectRatio);
+  fitInView(_scene->contentsBoundingRect(), Qt::KeepAspectRatio);
   clipCurrentScale();
 }
 
@@ -545,74 +574,80 @@ contextMenuEvent(QContextMenuEvent *event)
     return;
   }
 
-  QMenu modelMenu;
+  updateModelPalette();
 
-  auto skipText = QStringLiteral("skip me");
+  _modelMenuPos = menuPos;
 
-  //Add filterbox to the context menu
-  auto *txtBox = new QLineEdit(&modelMenu);
+  // the palette is kept between menus; only the trailing actions vary
+  auto const actions = _modelMenu->actions();
 
-  txtBox->setPlaceholderText(QStringLiteral("Filter"));
-  txtBox->setClearButtonEnabled(true);
+  for (int i = 2; i < actions.size(); ++i)
+    _modelMenu->removeAction(actions[i]);
 
-  auto *txtBoxAction = new QWidgetAction(&modelMenu);
-  txtBoxAction->setDefaultWidget(txtBox);
+  if (_scene->checkCopyableSelection())
+  {
+    _modelMenu->addAction(_createGroupFromSelectionAction);
+  }
 
-  modelMenu.addAction(txtBoxAction);
+  _modelMenu->addAction(_loadGroupAction);
+  _modelMenu->addAction(_copySelectionAction);
+  _modelMenu->addAction(_cutSelectionAction);
+  _modelMenu->addAction(_pasteClipboardAction);
 
-  //Add result treeview to the context menu
-  auto *treeView = new QTreeWidget(&modelMenu);
-  treeView->header()->close();
+  _modelFilter->clear();
 
-  auto *treeViewAction = new QWidgetAction(&modelMenu);
-  treeViewAction->setDefaultWidget(treeView);
+  // make sure the text box gets focus so the user doesn't have to click on it
+  _modelFilter->setFocus();
 
-  modelMenu.addAction(treeViewAction);
+  _modelMenu->exec(event->globalPos());
+  _pasteClipboardAction->setData(QVariant());
+  _loadGroupAction->setData(QVariant());
+}
 
-  QMap<QString, QTreeWidgetItem*> topLevelItems;
-  for (auto const &cat : _scene->registry().categories())
-  {
-    auto item = new QTreeWidgetItem(treeView);
-    item->setText(0, cat);
-    item->setData(0, Qt::UserRole, skipText);
-    topLevelItems[cat] = item;
-  }
 
-  std::unordered_map<QString, QString> nodes_map = _scene->registry().registeredModelsCategoryAssociation();
+void
+FlowView::
+createModelMenu()
+{
+  _modelMenu = new QMenu(this);
+
+  //Add filterbox to the context menu
+  _modelFilter = new QLineEdit(_modelMenu);
 
-  std::vector<std::pair<QString, QString>> nodes_pairs(nodes_map.begin(), nodes_map.end());
+  _modelFilter->setPlaceholderText(QStringLiteral("Filter"));
+  _modelFilter->setClearButtonEnabled(true);
 
-  std::sort(nodes_pairs.begin(), nodes_pairs.end(),
-            [](const auto& l_key, const auto& r_key) {
-              return l_key.first < r_key.first;
-            });
+  auto *txtBoxAction = new QWidgetAction(_modelMenu);
+  txtBoxAction->setDefaultWidget(_modelFilter);
 
-  for (auto const &assoc : nodes_pairs)
-  {
-    auto parent = topLevelItems[assoc.second];
-    auto item   = new QTreeWidgetItem(parent);
-    item->setText(0, assoc.first);
-    item->setData(0, Qt::UserRole, assoc.first);
-  }
+  _modelMenu->addAction(txtBoxAction);
+
+  //Add result treeview to the context menu
+  _modelTree = new QTreeWidget(_modelMenu);
+  _modelTree->header()->close();
 
-  treeView->expandAll();
+  auto *treeViewAction = new QWidgetAction(_modelMenu);
+  treeViewAction->setDefaultWidget(_modelTree);
 
-  auto selection_handler_fun =  [&](QTreeWidgetItem *item, int)
+  _modelMenu->addAction(treeViewAction);
+
+  auto selection_handler_fun = [this](QTreeWidgetItem *item, int)
   {
-    QString modelName = item->data(0, Qt::UserRole).toString();
+    QVariant const modelName = item->data(0, Qt::UserRole);
 
-    if (modelName == skipText)
+    // category items carry no model name
+    if (!modelName.isValid())
     {
       return;
     }
 
-    auto type = _scene->registry().create(modelName);
+    auto type = _scene->registry().create(modelName.toString());
 
     if (type)
     {
       auto& node = _scene->createNode(std::move(type));
 
-      node.nodeGraphicsObject().setPos(menuPos);
+      node.nodeGraphicsObject().setPos(_modelMenuPos);
 
       _scene->nodePlaced(node);
     }
@@ -621,44 +656,78 @@ contextMenuEvent(QContextMenuEvent *event)
       qDebug() << "Model not found";
     }
 
-    modelMenu.close();
+    _modelMenu->close();
   };
   // A node is created by both clicking with the mouse or pressing "Enter"
-  connect(treeView, &QTreeWidget::itemClicked, selection_handler_fun);
+  connect(_modelTree, &QTreeWidget::itemClicked, selection_handler_fun);
 
-  connect(treeView, &QTreeWidget::itemActivated, selection_handler_fun);
+  connect(_modelTree, &QTreeWidget::itemActivated, selection_handler_fun);
 
   //Setup filtering
-  connect(txtBox, &QLineEdit::textChanged, [&](const QString &text)
+  connect(_modelFilter, &QLineEdit::textChanged,
+          this, &FlowView::filterModelPalette);
+}
+
+
+void
+FlowView::
+updateModelPalette()
+{
+  if (!_modelMenu)
+    createModelMenu();
+
+  DataModelRegistry const& registry = _scene->registry();
+
+  if (_modelPaletteRevision == registry.revision())
+    return;
+
+  _modelPaletteIndex.update(registry);
+  _modelPaletteRevision = registry.revision();
+
+  _modelTree->clear();
+  _modelItems.clear();
+
+  QMap<QString, QTreeWidgetItem*> topLevelItems;
+  for (auto const &cat : registry.categories())
   {
-    for (auto& topLvlItem : topLevelItems)
-    {
-      for (int i = 0; i < topLvlItem->childCount(); ++i)
-      {
-        auto child = topLvlItem->child(i);
-        auto modelName = child->data(0, Qt::UserRole).toString();
-        const bool match = (modelName.contains(text, Qt::CaseInsensitive));
-        child->setHidden(!match);
-      }
-    }
-  });
+    auto item = new QTreeWidgetItem(_modelTree);
+    item->setText(0, cat);
+    topLevelItems[cat] = item;
+  }
 
-  if (_scene->checkCopyableSelection())
+  auto const& entries = _modelPaletteIndex.entries();
+
+  _modelItems.reserve(entries.size());
+
+  for (auto const &entry : entries)
   {
-    modelMenu.addAction(_createGroupFromSelectionAction);
+    auto parent = topLevelItems[entry.category];
+    auto item   = new QTreeWidgetItem(parent);
+    item->setText(0, entry.name);
+    item->setData(0, Qt::UserRole, entry.name);
+
+    _modelItems.push_back(item);
   }
 
-  modelMenu.addAction(_loadGroupAction);
-  modelMenu.addAction(_copySelectionAction);
-  modelMenu.addAction(_cutSelectionAction);
-  modelMenu.addAction(_pasteClipboardAction);
+  _modelTree->expandAll();
+}
 
-  // make sure the text box gets focus so the user doesn't have to click on it
-  txtBox->setFocus();
 
-  modelMenu.exec(event->globalPos());
-  _pasteClipboardAction->setData(QVariant());
-  _loadGroupAction->setData(QVariant());
+void
+FlowView::
+filterModelPalette(QString const& text)
+{
+  std::vector<bool> visible(_modelItems.size(), false);
+
+  for (auto i : _modelPaletteIndex.match(text))
+    visible[i] = true;
+
+  // only the items whose visibility changes are touched
+  for (std::size_t i = 0; i < _modelItems.size(); ++i)
+  {
+    if (_modelItems[i]->isHidden() == visible[i])
+      _modelItems[i]->setHidden(!visible[i]);
+  }
 }
 
 
@@ -822,49 +891,106 @@ drawBackground(QPainter* painter, const QRectF& r)
 {
   QGraphicsView::drawBackground(painter, r);
 
-  auto drawGrid =
-    [&](double gridStep)
+  // every pan and zoom ends up repainting the background
+  if (_scene)
   {
-    QRect   windowRect = rect();
-    QPointF tl = mapToScene(windowRect.topLeft());
-    QPointF br = mapToScene(windowRect.bottomRight());
+    QRectF const visibleArea = mapToScene(viewport()->rect()).boundingRect();
 
-    double left   = std::floor(tl.x() / gridStep - 0.5);
-    double right  = std::floor(br.x() / gridStep + 1.0);
-    double bottom = std::floor(tl.y() / gridStep - 0.5);
-    double top    = std::floor (br.y() / gridStep + 1.0);
-
-    // vertical lines
-    for (int xi = int(left); xi <= int(right); ++xi)
+    if (visibleArea != _lastVisibleArea)
     {
-      QLineF line(xi * gridStep, bottom * gridStep,
-                  xi * gridStep, top * gridStep );
-
-      painter->drawLine(line);
+      _lastVisibleArea = visibleArea;
+      _scene->scheduleVisibleAreaUpdate();
     }
+  }
+
+  double const scale = transform().m11();
+
+  if (scale <= 0.0)
+    return;
+
+  qreal const dpr = painter->device()->devicePixelRatioF();
+
+  QPixmap const tile = gridTile(scale, dpr);
+
+  // one tile covers a coarse grid cell; map its pixels back to scene units
+  double const unitsPerPixel = _coarseGridStep / tile.width();
 
-    // horizontal lines
-    for (int yi = int(bottom); yi <= int(top); ++yi)
+  QBrush brush(tile);
+  brush.setTransform(QTransform::fromScale(unitsPerPixel, unitsPerPixel));
+
+  painter->fillRect(r, brush);
+}
+
+
+QPixmap
+FlowView::
+gridTile(double scale, qreal dpr)
+{
+  auto const &flowViewStyle = StyleCollection::flowViewStyle();
+
+  // Tiles are rendered for quarter-octave zoom buckets and stretched by the
+  // brush transform in between.
+  int const bucket = qRound(std::log2(scale) * 4.0);
+
+  double const bucketScale = std::exp2(bucket / 4.0);
+
+  // On-screen spacing of the fine lines; they fade out below a few pixels.
+  double const fineSpacing = _fineGridStep * bucketScale;
+
+  double const fineOpacity =
+    std::clamp((fineSpacing - _fineGridFadeEnd) /
+               (_fineGridFadeStart - _fineGridFadeEnd), 0.0, 1.0);
+
+  QString const key = QStringLiteral("qtnodes_grid_%1_%2_%3_%4")
+                      .arg(bucket)
+                      .arg(qRound(dpr * 100.0))
+                      .arg(flowViewStyle.FineGridColor.rgba(), 8, 16, QLatin1Char('0'))
+                      .arg(flowViewStyle.CoarseGridColor.rgba(), 8, 16, QLatin1Char('0'));
+
+  QPixmap tile;
+
+  if (QPixmapCache::find(key, &tile))
+    return tile;
+
+  double const pixelsPerUnit = bucketScale * dpr;
+
+  int const side = std::max(1, qRound(_coarseGridStep * pixelsPerUnit));
+
+  tile = QPixmap(side, side);
+  tile.fill(Qt::transparent);
+
+  QPainter painter(&tile);
+
+  auto drawLines = [&](double step, QColor const& color)
+  {
+    painter.setPen(QPen(color, 0.0));
+
+    int const n = qRound(_coarseGridStep / step);
+
+    for (int i = 0; i < n; ++i)
     {
-      QLineF line(left * gridStep, yi * gridStep,
-                  right * gridStep, yi * gridStep );
-      painter->drawLine(line);
+      double const pos = std::floor(i * step * side / _coarseGridStep) + 0.5;
+
+      painter.drawLine(QLineF(pos, 0.0, pos, side));
+      painter.drawLine(QLineF(0.0, pos, side, pos));
     }
   };
 
-  auto const &flowViewStyle = StyleCollection::flowViewStyle();
+  if (fineOpacity > 0.0)
+  {
+    QColor fineColor = flowViewStyle.FineGridColor;
+    fineColor.setAlphaF(fineColor.alphaF() * fineOpacity);
 
-  QBrush bBrush = backgroundBrush();
+    drawLines(_fineGridStep, fineColor);
+  }
 
-  QPen pfine(flowViewStyle.FineGridColor, 1.0);
+  drawLines(_coarseGridStep, flowViewStyle.CoarseGridColor);
 
-  painter->setPen(pfine);
-  drawGrid(15);
+  painter.end();
 
-  QPen p(flowViewStyle.CoarseGridColor, 1.0);
+  QPixmapCache::insert(key, tile);
 
-  painter->setPen(p);
-  drawGrid(150);
+  return tile;
 }
 
 
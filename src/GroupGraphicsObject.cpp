@@ -1,17 +1,58 @@
 #include "GroupGraphicsObject.hpp"
 
 #include <QGraphicsSceneMouseEvent>
+#include <QSignalBlocker>
 #include <QStyleOptionGraphicsItem>
 #include <nodes/Node>
 
 #include "FlowScene.hpp"
 #include "Connection.hpp"
+#include "ConnectionGraphicsObject.hpp"
+#include "NodeGraphicsObject.hpp"
 
 using QtNodes::GroupGraphicsObject;
 using QtNodes::NodeGraphicsObject;
 using QtNodes::NodeGroup;
 using QtNodes::Connection;
+using QtNodes::ConnectionGraphicsObject;
 using QtNodes::FlowScene;
+using QtNodes::Node;
+using QtNodes::PortType;
+
+namespace
+{
+
+/// Calls `visit(cgo, internal)` once for every connection attached to the
+/// nodes of `group`. Internal connections join two nodes of the group.
+template <typename Visitor>
+void
+forEachGroupConnection(NodeGroup& group, Visitor visit)
+{
+  for (auto* node : group.childNodes())
+  {
+    for (PortType portType : {PortType::In, PortType::Out})
+    {
+      for (auto const& connections : node->nodeState().getEntries(portType))
+      {
+        for (auto const& entry : connections)
+        {
+          Connection* connection = entry.second;
+          Node* other = connection->getNode(QtNodes::oppositePort(portType));
+
+          bool const internal =
+            other && other->nodeGroup().lock().get() == &group;
+
+          // internal connections are seen from both of their ends
+          if (internal && portType == PortType::In)
+            continue;
+
+          visit(connection->getConnectionGraphicsObject(), internal);
+        }
+      }
+    }
+  }
+}
+}
 
 
 IconGraphicsItem::
@@ -44,6 +85,8 @@ GroupGraphicsObject(FlowScene& scene,
   , _group(nodeGroup)
   , _possibleChild(nullptr)
   , _locked(false)
+  , _movingNodes(false)
+  , _dragging(false)
 {
   setRect(0, 0, _defaultWidth, _defaultHeight);
 
@@ -65,6 +108,8 @@ GroupGraphicsObject(FlowScene& scene,
   setZValue(-_groupAreaZValue);
 
   setAcceptHoverEvents(true);
+
+  updateBounds();
 }
 
 
@@ -94,18 +139,186 @@ QRectF
 GroupGraphicsObject::
 boundingRect() const
 {
-  QRectF ret{};
+  return mapRectFromScene(_sceneBounds.marginsAdded(_margins));
+}
+
+
+void
+GroupGraphicsObject::
+updateBounds()
+{
+  _childRects.clear();
+
+  QRectF sceneBounds{};
   for (auto& node : _group.childNodes())
   {
-    NodeGraphicsObject* ngo = &node->nodeGraphicsObject();
+    NodeGraphicsObject const* ngo = &node->nodeGraphicsObject();
+    QRectF const childRect = childSceneRect(*ngo);
 
-    ret |= ngo->mapRectToScene(ngo->boundingRect());
+    _childRects[ngo] = childRect;
+    sceneBounds |= childRect;
   }
   if (_possibleChild)
   {
-    ret |= _possibleChild->mapRectToScene(_possibleChild->boundingRect());
+    QRectF const childRect = childSceneRect(*_possibleChild);
+
+    _childRects[_possibleChild] = childRect;
+    sceneBounds |= childRect;
+  }
+
+  setSceneBounds(sceneBounds);
+}
+
+
+void
+GroupGraphicsObject::
+updateChildBounds(NodeGraphicsObject const& ngo)
+{
+  if (_movingNodes)
+    return;
+
+  auto it = _childRects.find(&ngo);
+  if (it == _childRects.end())
+    return;
+
+  QRectF const oldRect = it->second;
+  QRectF const newRect = childSceneRect(ngo);
+
+  if (newRect == oldRect)
+    return;
+
+  it->second = newRect;
+
+  bool const wasOnBorder = oldRect.left() <= _sceneBounds.left()
+                           || oldRect.top() <= _sceneBounds.top()
+                           || oldRect.right() >= _sceneBounds.right()
+                           || oldRect.bottom() >= _sceneBounds.bottom();
+
+  if (!wasOnBorder)
+  {
+    setSceneBounds(_sceneBounds | newRect);
+    return;
+  }
+
+  // the node may have been holding the border in place, so the area may shrink
+  QRectF sceneBounds{};
+  for (auto const& childRect : _childRects)
+  {
+    sceneBounds |= childRect.second;
+  }
+  setSceneBounds(sceneBounds);
+}
+
+
+QRectF
+GroupGraphicsObject::
+childSceneRect(NodeGraphicsObject const& ngo)
+{
+  return ngo.mapRectToScene(ngo.node().nodeGeometry().boundingRect());
+}
+
+
+void
+GroupGraphicsObject::
+setSceneBounds(QRectF const& sceneBounds)
+{
+  QRectF const newRect = mapRectFromScene(sceneBounds.marginsAdded(_margins));
+
+  // e.g. the whole group was dragged along with its nodes
+  if (newRect == boundingRect())
+  {
+    _sceneBounds = sceneBounds;
+    return;
+  }
+
+  prepareGeometryChange();
+  _sceneBounds = sceneBounds;
+  setRect(newRect);
+  positionLockedIcon();
+}
+
+
+void
+GroupGraphicsObject::
+translateBounds(QPointF const& offset)
+{
+  for (auto& childRect : _childRects)
+  {
+    childRect.second.translate(offset);
+  }
+  setSceneBounds(_sceneBounds.translated(offset));
+
+  // the possible child is not part of the group and did not move with it
+  if (_possibleChild)
+  {
+    updateBounds();
+  }
+}
+
+
+void
+GroupGraphicsObject::
+beginDrag()
+{
+  _dragging = true;
+  _dragStartPos = pos();
+
+  // the items keep their scene positions; blocking their signals keeps the
+  // reparenting from being reported as node moves
+  auto adopt = [this](QGraphicsObject& item)
+  {
+    QSignalBlocker blocker(&item);
+    QPointF const scenePos = item.scenePos();
+    item.setParentItem(this);
+    item.setPos(mapFromScene(scenePos));
+  };
+
+  for (auto& node : _group.childNodes())
+  {
+    adopt(node->nodeGraphicsObject());
+  }
+
+  forEachGroupConnection(_group,
+                         [&adopt](ConnectionGraphicsObject& cgo, bool internal)
+  {
+    if (internal)
+      adopt(cgo);
+    cgo.move();
+  });
+}
+
+
+void
+GroupGraphicsObject::
+endDrag()
+{
+  _dragging = false;
+
+  auto release = [](QGraphicsObject& item)
+  {
+    QSignalBlocker blocker(&item);
+    QPointF const scenePos = item.scenePos();
+    item.setParentItem(nullptr);
+    item.setPos(scenePos);
+  };
+
+  for (auto& node : _group.childNodes())
+  {
+    release(node->nodeGraphicsObject());
+  }
+
+  forEachGroupConnection(_group,
+                         [&release](ConnectionGraphicsObject& cgo, bool internal)
+  {
+    if (internal)
+      release(cgo);
+    cgo.move();
+  });
+
+  if (pos() != _dragStartPos)
+  {
+    _scene.notifyNodesMoved(_group.childNodes());
   }
-  return mapRectFromScene(ret.marginsAdded(_margins));
 }
 
 void
@@ -140,10 +353,16 @@ void
 GroupGraphicsObject::
 moveNodes(const QPointF& offset)
 {
+  // every node moves by the same offset, so the cached area is translated
+  // as a whole instead of being updated once per node
+  _movingNodes = true;
   for (auto& node : group().childNodes())
   {
     node->nodeGraphicsObject().moveBy(offset.x(), offset.y());
   }
+  _movingNodes = false;
+
+  translateBounds(offset);
 }
 
 
@@ -208,6 +427,7 @@ GroupGraphicsObject::
 setPossibleChild(QtNodes::NodeGraphicsObject* possibleChild)
 {
   _possibleChild = possibleChild;
+  updateBounds();
 }
 
 
@@ -216,6 +436,7 @@ GroupGraphicsObject::
 unsetPossibleChild()
 {
   _possibleChild = nullptr;
+  updateBounds();
 }
 
 
@@ -253,16 +474,47 @@ hoverLeaveEvent(QGraphicsSceneHoverEvent* event)
   setHovered(false);
 }
 
+void
+GroupGraphicsObject::
+mousePressEvent(QGraphicsSceneMouseEvent* event)
+{
+  QGraphicsItem::mousePressEvent(event);
+  // locked groups don't move, so there's nothing to drag along
+  if (event->button() == Qt::LeftButton && !_dragging && !locked())
+  {
+    beginDrag();
+  }
+}
+
 void
 GroupGraphicsObject::
 mouseMoveEvent(QGraphicsSceneMouseEvent* event)
 {
+  QPointF const oldPos = pos();
   QGraphicsItem::mouseMoveEvent(event);
-  if (event->lastPos() != event->pos())
+
+  QPointF const offset = pos() - oldPos;
+  if (!_dragging || offset.isNull())
+    return;
+
+  // the nodes and internal connections follow the group's transform, only
+  // connections leaving the group have to be recomputed
+  translateBounds(offset);
+  forEachGroupConnection(_group, [](ConnectionGraphicsObject& cgo, bool internal)
+  {
+    if (!internal)
+      cgo.move();
+  });
+}
+
+void
+GroupGraphicsObject::
+mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
+{
+  QGraphicsItem::mouseReleaseEvent(event);
+  if (_dragging)
   {
-    auto diff = event->pos() - event->lastPos();
-    moveNodes(diff);
-    moveConnections();
+    endDrag();
   }
 }
 
@@ -282,9 +534,6 @@ paint(QPainter* painter,
       QWidget* widget)
 {
   Q_UNUSED(widget);
-  prepareGeometryChange();
-  setRect(boundingRect());
-  positionLockedIcon();
   painter->setClipRect(option->exposedRect);
   painter->setBrush(_currentFillColor);
 
@@ -0,0 +1,89 @@
+#include "IdGenerator.hpp"
+
+#include <atomic>
+
+#include <QtCore/QRandomGenerator>
+
+using QtNodes::IdGenerator;
+using QtNodes::ObjectId;
+
+namespace
+{
+
+struct UuidPrefix
+{
+  quint64 high;
+  quint64 low;
+};
+
+
+UuidPrefix const&
+uuidPrefix()
+{
+  static UuidPrefix const prefix{ QRandomGenerator::system()->generate64(),
+                                  QRandomGenerator::system()->generate64() };
+
+  return prefix;
+}
+}
+
+
+ObjectId
+IdGenerator::
+next()
+{
+  static std::atomic<ObjectId> counter{0};
+
+  return ++counter;
+}
+
+
+QUuid
+IdGenerator::
+uuid(ObjectId id)
+{
+  UuidPrefix const& prefix = uuidPrefix();
+
+  // the id only alters the low half, which keeps the mapping injective for
+  // any id below 2^62 once the variant bits are set
+  quint64 const high = prefix.high;
+  quint64 const low  = prefix.low ^ id;
+
+  return QUuid(static_cast<uint>(high >> 32),
+               static_cast<ushort>(high >> 16),
+               static_cast<ushort>((high & 0x0fff) | 0x4000), // version 4
+               static_cast<uchar>(((low >> 56) & 0x3f) | 0x80), // RFC 4122 variant
+               static_cast<uchar>(low >> 48),
+               static_cast<uchar>(low >> 40),
+               static_cast<uchar>(low >> 32),
+               static_cast<uchar>(low >> 24),
+               static_cast<uchar>(low >> 16),
+               static_cast<uchar>(low >> 8),
+               static_cast<uchar>(low));
+}
+
+
+ObjectId
+IdGenerator::
+objectId(QUuid const& uuid)
+{
+  UuidPrefix const& prefix = uuidPrefix();
+
+  quint64 low = 0;
+
+  for (uchar byte : uuid.data4)
+    low = (low << 8) | byte;
+
+  // ids stay below 2^62, so the bits replaced by the variant are the prefix's
+  quint64 constexpr variantMask = quint64(0xc0) << 56;
+
+  low = (low & ~variantMask) | (prefix.low & variantMask);
+
+  ObjectId const id = low ^ prefix.low;
+
+  // anything else, including the high half, must match as well
+  if (id == 0 || IdGenerator::uuid(id) != uuid)
+    return 0;
+
+  return id;
+}
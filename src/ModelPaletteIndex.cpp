@@ -0,0 +1,149 @@
+#include "ModelPaletteIndex.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "DataModelRegistry.hpp"
+
+using QtNodes::ModelPaletteIndex;
+using QtNodes::DataModelRegistry;
+
+namespace
+{
+
+/// Length of the longest indexed substrings
+constexpr int maxGramLength = 3;
+}
+
+
+void
+ModelPaletteIndex::
+update(DataModelRegistry const& registry)
+{
+  if (_revision == registry.revision())
+    return;
+
+  _revision = registry.revision();
+
+  _entries.clear();
+  _foldedNames.clear();
+  _grams.clear();
+
+  auto const& categories = registry.registeredModelsCategoryAssociation();
+
+  _entries.reserve(categories.size());
+
+  for (auto const& assoc : categories)
+    _entries.push_back(Entry{assoc.first, assoc.second});
+
+  std::sort(_entries.begin(), _entries.end(),
+            [](Entry const& l, Entry const& r)
+  {
+    return l.name < r.name;
+  });
+
+  _foldedNames.reserve(_entries.size());
+
+  for (std::uint32_t i = 0; i < _entries.size(); ++i)
+  {
+    QString const folded = _entries[i].name.toCaseFolded();
+
+    for (int length = 1; length <= maxGramLength; ++length)
+    {
+      for (int position = 0; position + length <= folded.size(); ++position)
+      {
+        auto & postings = _grams[gramKey(folded, position, length)];
+
+        // entries are visited in order, so a repeated substring of the same
+        // name can only be at the back
+        if (postings.empty() || postings.back() != i)
+          postings.push_back(i);
+      }
+    }
+
+    _foldedNames.push_back(folded);
+  }
+}
+
+
+std::vector<std::uint32_t>
+ModelPaletteIndex::
+match(QString const& filter) const
+{
+  std::vector<std::uint32_t> result;
+
+  QString const folded = filter.toCaseFolded();
+
+  if (folded.isEmpty())
+  {
+    result.resize(_entries.size());
+
+    for (std::uint32_t i = 0; i < result.size(); ++i)
+      result[i] = i;
+
+    return result;
+  }
+
+  int const length = std::min<int>(folded.size(), maxGramLength);
+
+  // the names containing the filter contain all of its substrings; start
+  // from the rarest one to keep the intersection small
+  std::vector<std::vector<std::uint32_t> const*> lists;
+
+  for (int position = 0; position + length <= folded.size(); ++position)
+  {
+    auto it = _grams.find(gramKey(folded, position, length));
+
+    if (it == _grams.end())
+      return result;
+
+    lists.push_back(&it->second);
+  }
+
+  std::sort(lists.begin(), lists.end(),
+            [](auto const* l, auto const* r)
+  {
+    return l->size() < r->size();
+  });
+
+  result = *lists.front();
+
+  std::vector<std::uint32_t> intersection;
+
+  for (std::size_t l = 1; l < lists.size() && !result.empty(); ++l)
+  {
+    intersection.clear();
+
+    std::set_intersection(result.begin(), result.end(),
+                          lists[l]->begin(), lists[l]->end(),
+                          std::back_inserter(intersection));
+
+    result.swap(intersection);
+  }
+
+  // longer filters only had their substrings checked, not their order
+  if (folded.size() > maxGramLength)
+  {
+    result.erase(std::remove_if(result.begin(), result.end(),
+                                [&](std::uint32_t i)
+    {
+      return !_foldedNames[i].contains(folded);
+    }),
+                 result.end());
+  }
+
+  return result;
+}
+
+
+ModelPaletteIndex::GramKey
+ModelPaletteIndex::
+gramKey(QString const& text, int position, int length)
+{
+  GramKey key = static_cast<GramKey>(length) << 48;
+
+  for (int i = 0; i < length; ++i)
+    key |= static_cast<GramKey>(text[position + i].unicode()) << (32 - 16 * i);
+
+  return key;
+}
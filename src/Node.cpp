@@ -1,7 +1,11 @@
 #include "Node.hpp"
 
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMetaObject>
 #include <QtCore/QObject>
+#include <QtCore/QSignalBlocker>
 
+#include <algorithm>
 #include <utility>
 #include <iostream>
 
@@ -9,26 +13,32 @@
 
 #include "NodeGraphicsObject.hpp"
 #include "NodeDataModel.hpp"
+#include "AsyncNodeDataModel.hpp"
 
 #include "ConnectionGraphicsObject.hpp"
 #include "ConnectionState.hpp"
 
 #include "NodeGroup.hpp"
 
+using QtNodes::AsyncNodeDataModel;
 using QtNodes::Node;
 using QtNodes::NodeGeometry;
 using QtNodes::NodeGroup;
+using QtNodes::IdGenerator;
 using QtNodes::NodeState;
 using QtNodes::NodeData;
 using QtNodes::NodeDataType;
 using QtNodes::NodeDataModel;
 using QtNodes::NodeGraphicsObject;
+using QtNodes::NodeProcessingStatus;
+using QtNodes::OutputCache;
+using QtNodes::DiskResultCache;
 using QtNodes::PortIndex;
 using QtNodes::PortType;
 
 Node::
 Node(std::unique_ptr<NodeDataModel> && dataModel)
-  : _uid(QUuid::createUuid())
+  : _objectId(IdGenerator::next())
   , _nodeDataModel(std::move(dataModel))
   , _nodeState(_nodeDataModel)
   , _nodeGeometry(_nodeDataModel)
@@ -38,15 +48,27 @@ Node(std::unique_ptr<NodeDataModel> && dataModel)
 
   // propagate data: model => node
   connect(_nodeDataModel.get(), &NodeDataModel::dataUpdated,
-          this, &Node::onDataUpdated);
+          this, &Node::onModelDataUpdated);
 
   connect(_nodeDataModel.get(), &NodeDataModel::embeddedWidgetSizeUpdated,
           this, &Node::onNodeSizeUpdated );
+
+  connect(_nodeDataModel.get(), &NodeDataModel::processingStatusChanged,
+          this, &Node::onProcessingStatusChanged);
 }
 
 
 Node::
-~Node() = default;
+~Node()
+{
+  // jobs still running or queued use the model, which is destroyed next
+  if (auto* model = qobject_cast<AsyncNodeDataModel*>(_nodeDataModel.get()))
+    model->cancelAndWait();
+
+  if (_outputCache)
+    _outputCache->remove(_objectId);
+}
+
 
 QJsonObject
 Node::
@@ -54,7 +76,7 @@ save() const
 {
   QJsonObject nodeJson;
 
-  nodeJson["id"] = _uid.toString();
+  nodeJson["id"] = id().toString();
 
   nodeJson["model"] = _nodeDataModel->save();
 
@@ -63,6 +85,17 @@ save() const
   obj["y"] = _nodeGraphicsObject->pos().y();
   nodeJson["position"] = obj;
 
+  if (_frozen)
+  {
+    nodeJson["frozen"] = true;
+
+    // pinned outputs are saved when all of them can be serialized
+    QByteArray outputs;
+
+    if (DiskResultCache::encode(_frozenOutputs, outputs))
+      nodeJson["frozen_outputs"] = QString::fromLatin1(outputs.toBase64());
+  }
+
   return nodeJson;
 }
 
@@ -81,6 +114,31 @@ restore(QJsonObject const& json)
   _nodeGraphicsObject->setPos(point);
 
   _nodeDataModel->restore(json["model"].toObject());
+
+  if (json["frozen"].toBool())
+  {
+    QByteArray const bytes =
+      QByteArray::fromBase64(json["frozen_outputs"].toString().toLatin1());
+
+    OutputCache::Outputs outputs;
+
+    // reading pinned outputs takes the deserializers of a result cache;
+    // without them the node is frozen after its restored inputs are computed
+    if (_resultCache && !bytes.isEmpty() && _resultCache->decode(bytes, outputs))
+    {
+      bool const wasRecording = recordsInputs();
+
+      _frozenOutputs = std::move(outputs);
+      _frozen        = true;
+
+      updateInputRecording(wasRecording);
+      updateInputConnections();
+    }
+    else
+    {
+      _freezeAfterLoad = true;
+    }
+  }
 }
 
 
@@ -88,9 +146,20 @@ QUuid
 Node::
 id() const
 {
+  if (_uid.isNull())
+    _uid = IdGenerator::uuid(_objectId);
+
   return _uid;
 }
 
+
+QtNodes::ObjectId
+Node::
+objectId() const
+{
+  return _objectId;
+}
+
 void
 Node::
 reactToPossibleConnection(PortType reactingPortType,
@@ -211,18 +280,188 @@ bool Node::isInGroup() const
   return !_nodeGroup.expired();
 }
 
+
+void
+Node::
+setOutputCache(std::shared_ptr<OutputCache> cache)
+{
+  if (cache == _outputCache)
+    return;
+
+  bool const wasRecording = recordsInputs();
+
+  if (_outputCache)
+    _outputCache->remove(_objectId);
+
+  if (_modelInputsStale)
+    restoreModelInputs(INVALID);
+
+  _outputCache = std::move(cache);
+
+  updateInputRecording(wasRecording);
+}
+
+
+std::shared_ptr<OutputCache> const&
+Node::
+outputCache() const
+{
+  return _outputCache;
+}
+
+
+void
+Node::
+setResultCache(std::shared_ptr<DiskResultCache> cache)
+{
+  bool const wasRecording = recordsInputs();
+
+  _resultCache = std::move(cache);
+
+  updateInputRecording(wasRecording);
+}
+
+
+std::shared_ptr<DiskResultCache> const&
+Node::
+resultCache() const
+{
+  return _resultCache;
+}
+
+
+std::shared_ptr<NodeData>
+Node::
+outData(PortIndex index) const
+{
+  if (_frozen)
+  {
+    if (index < 0 || static_cast<std::size_t>(index) >= _frozenOutputs.size())
+      return nullptr;
+
+    return _frozenOutputs[index];
+  }
+
+  if (!_modelInputsStale)
+    return _nodeDataModel->outData(index);
+
+  if (index < 0 || static_cast<std::size_t>(index) >= _cachedOutputs.size())
+    return nullptr;
+
+  return _cachedOutputs[index];
+}
+
+
+void
+Node::
+setFrozen(bool frozen)
+{
+  _freezeAfterLoad = false;
+
+  if (frozen == _frozen)
+    return;
+
+  bool const wasRecording = recordsInputs();
+
+  if (frozen)
+  {
+    unsigned int const nOutputs = _nodeDataModel->nPorts(PortType::Out);
+
+    OutputCache::Outputs outputs;
+    outputs.reserve(nOutputs);
+
+    for (unsigned int i = 0; i < nOutputs; ++i)
+      outputs.push_back(outData(i));
+
+    _frozenOutputs = std::move(outputs);
+    _frozen        = true;
+  }
+  else
+  {
+    _frozen = false;
+    _frozenOutputs.clear();
+
+    if (_modelInputsStale)
+    {
+      restoreModelInputs(INVALID);
+      updateGraphics();
+    }
+
+    // the model's outputs may differ from the pinned ones
+    for (unsigned int i = 0; i < _nodeDataModel->nPorts(PortType::Out); ++i)
+      onDataUpdated(i);
+  }
+
+  updateInputRecording(wasRecording);
+
+  updateInputConnections();
+
+  _nodeGraphicsObject->update();
+}
+
+
+bool
+Node::
+isFrozen() const
+{
+  return _frozen;
+}
+
 void
 Node::
 propagateData(std::shared_ptr<NodeData> nodeData,
-              PortIndex inPortIndex) const
+              PortIndex inPortIndex)
 {
+  if (inPortIndex >= 0 && recordsInputs())
+  {
+    std::size_t const nInputs = _nodeDataModel->nPorts(PortType::In);
+
+    _inputs.resize(std::max<std::size_t>(nInputs, inPortIndex + 1));
+    _inputs[inPortIndex] = nodeData;
+  }
+
+  // a frozen model gets its inputs back when the node is unfrozen
+  if (_frozen)
+  {
+    _modelInputsStale = true;
+    return;
+  }
+
+  if (_outputCache || _resultCache)
+  {
+    QByteArray const state = modelState();
+
+    if (_outputCache)
+    {
+      if (auto outputs = _outputCache->find(outputCacheKey(state)))
+      {
+        serveCachedOutputs(*outputs);
+        return;
+      }
+    }
+
+    if (_resultCache && !_resultCache->verifyMode())
+    {
+      QByteArray const key = DiskResultCache::makeKey(state, _inputs);
+      OutputCache::Outputs outputs;
+
+      if (!key.isEmpty() && _resultCache->load(key, outputs))
+      {
+        if (_outputCache)
+          _outputCache->insert(outputCacheKey(state), outputs, _inputs);
+
+        serveCachedOutputs(std::move(outputs));
+        return;
+      }
+    }
+  }
+
+  if (_modelInputsStale)
+    restoreModelInputs(inPortIndex);
+
   _nodeDataModel->setInData(std::move(nodeData), inPortIndex);
 
-  //Recalculate the nodes visuals. A data change can result in the node taking more space than before, so this forces a recalculate+repaint on the affected node
-  _nodeGraphicsObject->setGeometryChanged();
-  _nodeGeometry.recalculateSize();
-  _nodeGraphicsObject->update();
-  _nodeGraphicsObject->moveConnections();
+  updateGraphics();
 }
 
 
@@ -230,7 +469,7 @@ void
 Node::
 onDataUpdated(PortIndex index)
 {
-  auto nodeData = _nodeDataModel->outData(index);
+  auto nodeData = outData(index);
 
   auto connections =
     _nodeState.connections(PortType::Out, index);
@@ -243,9 +482,11 @@ void
 Node::
 onNodeSizeUpdated()
 {
-  if( nodeDataModel()->embeddedWidget() )
+  _nodeDataModel->invalidateLayout();
+
+  if( auto w = nodeDataModel()->createdEmbeddedWidget() )
   {
-    nodeDataModel()->embeddedWidget()->adjustSize();
+    w->adjustSize();
   }
   nodeGeometry().recalculateSize();
   for(PortType type:
@@ -262,4 +503,249 @@ onNodeSizeUpdated()
       }
     }
   }
+  nodeGraphicsObject().updateGroupBounds();
+}
+
+
+void
+Node::
+onProcessingStatusChanged()
+{
+  _nodeDataModel->invalidateLayout();
+
+  // asynchronous models change status after propagateData() returned
+  if (_nodeGraphicsObject)
+    _nodeGraphicsObject->update();
+}
+
+
+void
+Node::
+onModelDataUpdated(PortIndex index)
+{
+  // new outputs may change what the node displays, even while frozen
+  _nodeDataModel->invalidateLayout();
+
+  // downstream nodes get the model's outputs when the node is unfrozen
+  if (_frozen)
+    return;
+
+  bool const wasStale = _modelInputsStale;
+
+  // the model reported on the inputs it had before the cache took over
+  if (wasStale)
+  {
+    restoreModelInputs(INVALID);
+
+    // an asynchronous model now computes the current inputs and reports
+    // them later; its outputs are still those of the outdated ones
+    if (modelComputing())
+      return;
+  }
+
+  scheduleCacheUpdate();
+
+  if (!wasStale)
+  {
+    onDataUpdated(index);
+    return;
+  }
+
+  for (unsigned int i = 0; i < _nodeDataModel->nPorts(PortType::Out); ++i)
+    onDataUpdated(i);
+}
+
+
+void
+Node::
+updateGraphics()
+{
+  // new inputs may change anything the node displays, widgets included
+  _nodeDataModel->invalidateLayout();
+
+  //Recalculate the nodes visuals. A data change can result in the node taking more space than before, so this forces a recalculate+repaint on the affected node
+  _nodeGraphicsObject->setGeometryChanged();
+  _nodeGeometry.recalculateSize();
+  _nodeGraphicsObject->update();
+  _nodeGraphicsObject->moveConnections();
+  _nodeGraphicsObject->updateGroupBounds();
+  _nodeGraphicsObject->scheduleWidgetSnapshot();
+}
+
+
+QByteArray
+Node::
+modelState() const
+{
+  return QJsonDocument(_nodeDataModel->save()).toJson(QJsonDocument::Compact);
+}
+
+
+OutputCache::Key
+Node::
+outputCacheKey(QByteArray const& state) const
+{
+  return OutputCache::makeKey(_objectId, state, _inputs);
+}
+
+
+void
+Node::
+serveCachedOutputs(OutputCache::Outputs outputs)
+{
+  _cachedOutputs    = std::move(outputs);
+  _modelInputsStale = true;
+
+  for (PortIndex i = 0; i < static_cast<PortIndex>(_cachedOutputs.size()); ++i)
+    onDataUpdated(i);
+}
+
+
+void
+Node::
+scheduleCacheUpdate()
+{
+  if (!_outputCache && !_resultCache)
+    return;
+
+  // the model reports on the inputs it has, which are the current ones
+  _reportedInputs = _inputs;
+
+  if (_cacheUpdatePending)
+    return;
+
+  _cacheUpdatePending = true;
+
+  QMetaObject::invokeMethod(this, [this] { updateCaches(); }, Qt::QueuedConnection);
+}
+
+
+void
+Node::
+updateCaches()
+{
+  _cacheUpdatePending = false;
+
+  if (!_outputCache && !_resultCache)
+    return;
+
+  // newer inputs reached the node since; their outputs are stored once the
+  // model reports them, or were served from the cache
+  if (_modelInputsStale || _reportedInputs != _inputs)
+    return;
+
+  unsigned int const nOutputs = _nodeDataModel->nPorts(PortType::Out);
+
+  OutputCache::Outputs outputs;
+  outputs.reserve(nOutputs);
+
+  for (unsigned int i = 0; i < nOutputs; ++i)
+    outputs.push_back(_nodeDataModel->outData(i));
+
+  QByteArray const state = modelState();
+
+  if (_resultCache)
+  {
+    QByteArray const key = DiskResultCache::makeKey(state, _inputs);
+
+    if (_resultCache->verifyMode())
+      _resultCache->verify(key, outputs);
+    else
+      _resultCache->store(key, outputs);
+  }
+
+  if (_outputCache)
+    _outputCache->insert(outputCacheKey(state), std::move(outputs), _inputs);
+}
+
+
+bool
+Node::
+modelComputing() const
+{
+  NodeProcessingStatus const status = _nodeDataModel->processingStatus();
+
+  return status == NodeProcessingStatus::Pending ||
+         status == NodeProcessingStatus::Processing;
+}
+
+
+void
+Node::
+restoreModelInputs(PortIndex skippedPort)
+{
+  {
+    QSignalBlocker blocker(_nodeDataModel.get());
+
+    PortIndex const nInputs =
+      std::min<PortIndex>(_inputs.size(), _nodeDataModel->nPorts(PortType::In));
+
+    for (PortIndex i = 0; i < nInputs; ++i)
+    {
+      if (i != skippedPort)
+        _nodeDataModel->setInData(_inputs[i], i);
+    }
+  }
+
+  _modelInputsStale = false;
+  _cachedOutputs.clear();
+}
+
+
+bool
+Node::
+recordsInputs() const
+{
+  return _outputCache || _resultCache || _frozen;
+}
+
+
+void
+Node::
+updateInputRecording(bool wasRecording)
+{
+  if (!recordsInputs())
+  {
+    _inputs.clear();
+    _inputs.shrink_to_fit();
+    _reportedInputs.clear();
+    return;
+  }
+
+  if (wasRecording)
+    return;
+
+  unsigned int const nInputs = _nodeDataModel->nPorts(PortType::In);
+
+  _inputs.assign(nInputs, nullptr);
+
+  for (unsigned int i = 0; i < nInputs; ++i)
+  {
+    for (auto const& entry : _nodeState.connections(PortType::In, i))
+      _inputs[i] = entry.second->sourceData();
+  }
+}
+
+
+void
+Node::
+updateInputConnections()
+{
+  for (auto const& connections : _nodeState.getEntries(PortType::In))
+  {
+    for (auto const& entry : connections)
+    {
+      entry.second->connectionGeometry().setFrozen(_frozen);
+      entry.second->getConnectionGraphicsObject().update();
+    }
+  }
+}
+
+
+void
+Node::
+applyRestoredFreeze()
+{
+  if (_freezeAfterLoad)
+    setFrozen(true);
 }
@@ -109,16 +109,18 @@ canConnect(PortIndex &portIndex, TypeConverter & converter) const
   auto const   &modelTarget = _node->nodeDataModel();
   NodeDataType candidateNodeDataType = modelTarget->dataType(requiredPort, portIndex);
 
-  if (connectionDataType.id != candidateNodeDataType.id)
+  NodeDataType const & from = (requiredPort == PortType::In) ?
+                              connectionDataType : candidateNodeDataType;
+  NodeDataType const & to   = (requiredPort == PortType::In) ?
+                              candidateNodeDataType : connectionDataType;
+
+  if (!_scene->registry().compatible(from, to))
+    return false;
+
+  // the converter itself is only looked up once the types are known to differ
+  if (from != to)
   {
-    if (requiredPort == PortType::In)
-    {
-      converter = _scene->registry().getTypeConverter(connectionDataType, candidateNodeDataType);
-    }
-    else if (requiredPort == PortType::Out)
-    {
-      converter = _scene->registry().getTypeConverter(candidateNodeDataType , connectionDataType);
-    }
+    converter = _scene->registry().getTypeConverter(from, to);
 
     return (converter != nullptr);
   }
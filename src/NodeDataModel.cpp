@@ -7,7 +7,7 @@ using QtNodes::NodeStyle;
 
 NodeDataModel::
 NodeDataModel()
-  : _nodeStyle(StyleCollection::nodeStyle())
+  : _nodeStyle(StyleCollection::sharedNodeStyle())
 {
   // Derived classes can initialize specific style here
 }
@@ -30,7 +30,7 @@ NodeStyle const&
 NodeDataModel::
 nodeStyle() const
 {
-  return _nodeStyle;
+  return *_nodeStyle;
 }
 
 
@@ -38,5 +38,58 @@ void
 NodeDataModel::
 setNodeStyle(NodeStyle const& style)
 {
-  _nodeStyle = style;
+  // equal overrides share one instance instead of a copy per model
+  _nodeStyle = StyleCollection::sharedNodeStyle(style);
+}
+
+
+void
+NodeDataModel::
+setNodeStyle(std::shared_ptr<NodeStyle const> style)
+{
+  if (style)
+    _nodeStyle = std::move(style);
+}
+
+
+QWidget*
+NodeDataModel::
+createdEmbeddedWidget()
+{
+  if (_embeddedWidgetMissing ||
+      (embeddedWidgetDeferred() && !_embeddedWidgetCreated))
+    return nullptr;
+
+  return embeddedWidget();
+}
+
+
+QWidget*
+NodeDataModel::
+createEmbeddedWidget()
+{
+  if (_embeddedWidgetMissing)
+    return nullptr;
+
+  _embeddedWidgetCreated = true;
+
+  QWidget* w = embeddedWidget();
+
+  _embeddedWidgetMissing = (w == nullptr);
+
+  return w;
+}
+
+
+QSize
+NodeDataModel::
+embeddedWidgetSize()
+{
+  if (auto w = createdEmbeddedWidget())
+    return w->size();
+
+  if (_embeddedWidgetMissing || !embeddedWidgetDeferred())
+    return QSize();
+
+  return embeddedWidgetSizeHint();
 }
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <cmath>
+#include <unordered_map>
 
 #include "PortType.hpp"
 #include "NodeState.hpp"
@@ -10,12 +11,32 @@
 #include "NodeGraphicsObject.hpp"
 
 #include "StyleCollection.hpp"
+#include "QStringStdHash.hpp"
 
 using QtNodes::NodeGeometry;
 using QtNodes::NodeDataModel;
+using QtNodes::NodeDataType;
 using QtNodes::PortIndex;
 using QtNodes::PortType;
 using QtNodes::Node;
+using QtNodes::TypeHandle;
+
+struct NodeGeometry::TextMetrics
+{
+  QFont font;
+  QFontMetrics regular;
+  QFontMetrics bold;
+};
+
+struct NodeGeometry::StatusIcons
+{
+  QIcon const updated{"://status_icons/updated.svg"};
+  QIcon const processing{"://status_icons/processing.svg"};
+  QIcon const pending{"://status_icons/pending.svg"};
+  QIcon const failed{"://status_icons/failed.svg"};
+  QIcon const empty{"://status_icons/empty.svg"};
+  QIcon const partial{"://status_icons/partial.svg"};
+};
 
 NodeGeometry::
 NodeGeometry(std::unique_ptr<NodeDataModel> const &dataModel)
@@ -28,14 +49,21 @@ NodeGeometry(std::unique_ptr<NodeDataModel> const &dataModel)
   , _hovered(false)
   , _draggingPos(-1000, -1000)
   , _dataModel(dataModel)
-  , _fontMetrics(QFont())
-  , _boldFontMetrics(QFont())
+  , _textMetrics(sharedTextMetrics(QFont()))
+  , _layoutRevision(0)
+  , _layoutSinks(0)
+  , _layoutSources(0)
+  , _layoutValid(false)
+  , _captionHeight(0)
+  , _captionWidth(0)
+  , _nicknameHeight(0)
+  , _nicknameWidth(0)
+  , _validationHeight(0)
+  , _validationWidth(0)
+  , _textAscent(0)
+  , _boldTextAscent(0)
+  , _statusIcons(sharedStatusIcons())
 {
-  QFont f;
-  f.setBold(true);
-
-  _boldFontMetrics = QFontMetrics(f);
-
   _statusIconActive = _dataModel->processingStatus() != NodeProcessingStatus::NoStatus;
   _statusIconSize.setWidth(_statusIconActive? 32 : 0);
   _statusIconSize.setHeight(_statusIconActive? 32 : 0);
@@ -85,7 +113,9 @@ void
 NodeGeometry::
 recalculateSize() const
 {
-  _entryHeight = _fontMetrics.height();
+  updateTextLayout();
+
+  _entryHeight = _textMetrics->regular.height();
 
   {
     unsigned int maxNumOfEntries = std::max(nSinks(), nSources());
@@ -93,9 +123,12 @@ recalculateSize() const
     _height = step * maxNumOfEntries + _statusIconSize.height() + spacing();
   }
 
-  if (auto w = _dataModel->embeddedWidget())
+  // deferred widgets are laid out from their size hint until created
+  QSize const widgetSize = _dataModel->embeddedWidgetSize();
+
+  if (widgetSize.isValid())
   {
-    _height = std::max(_height, static_cast<unsigned>(w->height()));
+    _height = std::max(_height, static_cast<unsigned>(widgetSize.height()));
   }
 
   _height += captionHeight() + nicknameHeight();
@@ -107,9 +140,9 @@ recalculateSize() const
                     static_cast<unsigned int>(_statusIconSize.width())) +
            2 * _spacing;
 
-  if (auto w = _dataModel->embeddedWidget())
+  if (widgetSize.isValid())
   {
-    _width += w->width();
+    _width += widgetSize.width();
   }
 
   _width = std::max(_width, captionWidth());
@@ -127,20 +160,154 @@ void
 NodeGeometry::
 recalculateSize(QFont const & font) const
 {
-  QFontMetrics fontMetrics(font);
-  QFont boldFont = font;
+  if (_layoutValid &&
+      _textMetrics->font == font &&
+      _layoutRevision == _dataModel->revision() &&
+      _layoutSinks == nSinks() &&
+      _layoutSources == nSources())
+  {
+    return;
+  }
+
+  if (_textMetrics->font != font)
+  {
+    _textMetrics = sharedTextMetrics(font);
+  }
+
+  recalculateSize();
+}
+
+
+QStaticText const&
+NodeGeometry::
+portText(PortType portType, PortIndex index) const
+{
+  static QStaticText const empty;
+
+  auto const& texts = (portType == PortType::In) ? _inPortTexts : _outPortTexts;
+
+  if (index < 0 || static_cast<size_t>(index) >= texts.size())
+    return empty;
+
+  return texts[index];
+}
+
+
+TypeHandle
+NodeGeometry::
+portTypeHandle(PortType portType, PortIndex index) const
+{
+  auto const& types = (portType == PortType::In) ? _inPortTypes : _outPortTypes;
+
+  if (index < 0 || static_cast<size_t>(index) >= types.size())
+    return QtNodes::InvalidTypeHandle;
+
+  return types[index];
+}
+
 
+void
+NodeGeometry::
+updateTextLayout() const
+{
+  auto prepared = [](QString const& text, QFont const& font)
+  {
+    QStaticText staticText(text);
+    staticText.setTextFormat(Qt::PlainText);
+    staticText.prepare(QTransform(), font);
+    return staticText;
+  };
+
+  QFont const& font = _textMetrics->font;
+  QFontMetrics const& fontMetrics = _textMetrics->regular;
+  QFontMetrics const& boldFontMetrics = _textMetrics->bold;
+
+  QFont boldFont = font;
   boldFont.setBold(true);
 
-  QFontMetrics boldFontMetrics(boldFont);
+  _captionHeight = 0;
+  _captionWidth  = 0;
+  _captionText   = QStaticText();
+
+  if (_dataModel->captionVisible())
+  {
+    QString const name = _dataModel->caption();
+    bool const nicknameVisible = _dataModel->nicknameVisible();
+
+    QRect const rect = nicknameVisible ?
+                       fontMetrics.boundingRect(name) :
+                       boldFontMetrics.boundingRect(name);
+
+    _captionHeight = rect.height();
+    _captionWidth  = rect.width();
+
+    QFont captionFont = font;
+    captionFont.setBold(!nicknameVisible);
+    captionFont.setItalic(nicknameVisible);
 
-  if (_boldFontMetrics != boldFontMetrics)
+    _captionText = prepared(name, captionFont);
+  }
+
+  _nicknameHeight = 0;
+  _nicknameWidth  = 0;
+  _nicknameText   = QStaticText();
+
+  if (_dataModel->nicknameVisible())
   {
-    _fontMetrics     = fontMetrics;
-    _boldFontMetrics = boldFontMetrics;
+    QString const nickname = _dataModel->nickname();
+    QRect const rect = boldFontMetrics.boundingRect(nickname);
 
-    recalculateSize();
+    _nicknameHeight = rect.height();
+    _nicknameWidth  = rect.width();
+    _nicknameText   = prepared(nickname, boldFont);
+  }
+
+  _validationHeight = 0;
+  _validationWidth  = 0;
+  _validationText   = QStaticText();
+
+  if (_dataModel->validationState() != NodeValidationState::Valid)
+  {
+    QString const msg = _dataModel->validationMessage();
+    QRect const rect = boldFontMetrics.boundingRect(msg);
+
+    _validationHeight = rect.height();
+    _validationWidth  = rect.width();
+    _validationText   = prepared(msg, font);
+  }
+
+  for (PortType portType: {PortType::In, PortType::Out})
+  {
+    auto& texts = (portType == PortType::In) ? _inPortTexts : _outPortTexts;
+    auto& types = (portType == PortType::In) ? _inPortTypes : _outPortTypes;
+
+    unsigned int const n = _dataModel->nPorts(portType);
+
+    texts.clear();
+    texts.reserve(n);
+    types.clear();
+    types.reserve(n);
+
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      NodeDataType const dataType = _dataModel->dataType(portType, i);
+
+      QString const name = _dataModel->portCaptionVisible(portType, i) ?
+                           _dataModel->portCaption(portType, i) :
+                           dataType.name;
+
+      texts.push_back(prepared(name, font));
+      types.push_back(dataType.handle());
+    }
   }
+
+  _textAscent     = fontMetrics.ascent();
+  _boldTextAscent = boldFontMetrics.ascent();
+
+  _layoutRevision = _dataModel->revision();
+  _layoutSinks    = nSinks();
+  _layoutSources  = nSources();
+  _layoutValid    = true;
 }
 
 
@@ -243,27 +410,29 @@ QPointF
 NodeGeometry::
 widgetPosition() const
 {
-  if (auto w = _dataModel->embeddedWidget())
+  // deferred widgets are laid out from their size hint until created
+  QSize const widgetSize = _dataModel->embeddedWidgetSize();
+
+  if (!widgetSize.isValid())
+    return QPointF();
+
+  auto w = _dataModel->createdEmbeddedWidget();
+
+  if (w && (w->sizePolicy().verticalPolicy() & QSizePolicy::ExpandFlag))
   {
-    if (w->sizePolicy().verticalPolicy() & QSizePolicy::ExpandFlag)
-    {
-      // If the widget wants to use as much vertical space as possible, place it immediately after the caption.
-      return QPointF(_spacing + portWidth(PortType::In), captionHeight() + nicknameHeight());
-    }
-    else
-    {
-      if (_dataModel->validationState() != NodeValidationState::Valid)
-      {
-        return QPointF(_spacing + portWidth(PortType::In),
-                       (captionHeight() + nicknameHeight() + _height
-                        - validationHeight() - _spacing - w->height()) / 2.0);
-      }
-
-      return QPointF(_spacing + portWidth(PortType::In),
-                     (captionHeight() + nicknameHeight() + _height - w->height()) / 2.0);
-    }
+    // If the widget wants to use as much vertical space as possible, place it immediately after the caption.
+    return QPointF(_spacing + _inputPortWidth, captionHeight() + nicknameHeight());
+  }
+
+  if (_dataModel->validationState() != NodeValidationState::Valid)
+  {
+    return QPointF(_spacing + _inputPortWidth,
+                   (captionHeight() + nicknameHeight() + _height
+                    - validationHeight() - _spacing - widgetSize.height()) / 2.0);
   }
-  return QPointF();
+
+  return QPointF(_spacing + _inputPortWidth,
+                 (captionHeight() + nicknameHeight() + _height - widgetSize.height()) / 2.0);
 }
 
 int
@@ -282,14 +451,7 @@ unsigned int
 NodeGeometry::
 captionHeight() const
 {
-  if (!_dataModel->captionVisible())
-    return 0;
-
-  QString name = _dataModel->caption();
-
-  return _dataModel->nicknameVisible()?
-         _fontMetrics.boundingRect(name).height() :
-         _boldFontMetrics.boundingRect(name).height();
+  return _captionHeight;
 }
 
 
@@ -297,38 +459,21 @@ unsigned int
 NodeGeometry::
 captionWidth() const
 {
-  if (!_dataModel->captionVisible())
-    return 0;
-
-  QString name = _dataModel->caption();
-
-  return _dataModel->nicknameVisible()?
-         _fontMetrics.boundingRect(name).width() :
-         _boldFontMetrics.boundingRect(name).width();
+  return _captionWidth;
 }
 
 unsigned int
 NodeGeometry::
 nicknameHeight() const
 {
-  if (!_dataModel->nicknameVisible())
-    return 0;
-
-  QString nickname = _dataModel->nickname();
-
-  return _boldFontMetrics.boundingRect(nickname).height();
+  return _nicknameHeight;
 }
 
 unsigned int
 NodeGeometry::
 nicknameWidth() const
 {
-  if (!_dataModel->nicknameVisible())
-    return 0;
-
-  QString nickname = _dataModel->nickname();
-
-  return _boldFontMetrics.boundingRect(nickname).width();
+  return _nicknameWidth;
 }
 
 
@@ -336,9 +481,7 @@ unsigned int
 NodeGeometry::
 validationHeight() const
 {
-  QString msg = _dataModel->validationMessage();
-
-  return _boldFontMetrics.boundingRect(msg).height();
+  return _validationHeight;
 }
 
 
@@ -346,9 +489,7 @@ unsigned int
 NodeGeometry::
 validationWidth() const
 {
-  QString msg = _dataModel->validationMessage();
-
-  return _boldFontMetrics.boundingRect(msg).width();
+  return _validationWidth;
 }
 
 
@@ -411,48 +552,91 @@ processingStatusIcon() const
   {
   case NodeProcessingStatus::NoStatus:
   case NodeProcessingStatus::Updated:
-    return _statusUpdated;
+    return _statusIcons->updated;
   case NodeProcessingStatus::Processing:
-    return _statusProcessing;
+    return _statusIcons->processing;
   case NodeProcessingStatus::Pending:
-    return _statusPending;
+    return _statusIcons->pending;
   case NodeProcessingStatus::Empty:
-    return _statusEmpty;
+    return _statusIcons->empty;
   case NodeProcessingStatus::Failed:
-    return _statusInvalid;
+    return _statusIcons->failed;
   case NodeProcessingStatus::Partial:
-    return _statusPartial;
+    return _statusIcons->partial;
   }
-  return _statusInvalid;
+  return _statusIcons->failed;
 }
 
 
-unsigned int
+std::shared_ptr<NodeGeometry::TextMetrics const>
 NodeGeometry::
-portWidth(PortType portType) const
+sharedTextMetrics(QFont const& font)
 {
-  unsigned width = 0;
+  // geometries are only laid out from the GUI thread
+  static std::unordered_map<QString, std::weak_ptr<TextMetrics const>> cache;
 
-  for (auto i = 0ul; i < _dataModel->nPorts(portType); ++i)
+  QString const key = font.key();
+
+  auto it = cache.find(key);
+
+  if (it != cache.end())
   {
-    QString name;
+    if (auto metrics = it->second.lock())
+      return metrics;
+  }
 
-    if (_dataModel->portCaptionVisible(portType, i))
-    {
-      name = _dataModel->portCaption(portType, i);
-    }
+  // drop the entries of fonts no geometry uses any more
+  for (auto entry = cache.begin(); entry != cache.end();)
+  {
+    if (entry->second.expired())
+      entry = cache.erase(entry);
     else
-    {
-      name = _dataModel->dataType(portType, i).name;
-    }
+      ++entry;
+  }
 
-#if QT_VERSION < QT_VERSION_CHECK(5,13,0)
-    width = std::max(unsigned(_fontMetrics.width(name)),
-                     width);
-#else
-    width = std::max(unsigned(_fontMetrics.horizontalAdvance(name)),
+  QFont boldFont = font;
+  boldFont.setBold(true);
+
+  auto metrics =
+    std::make_shared<TextMetrics const>(TextMetrics{font,
+                                                    QFontMetrics(font),
+                                                    QFontMetrics(boldFont)});
+
+  cache[key] = metrics;
+
+  return metrics;
+}
+
+
+std::shared_ptr<NodeGeometry::StatusIcons const>
+NodeGeometry::
+sharedStatusIcons()
+{
+  static std::weak_ptr<StatusIcons const> cache;
+
+  if (auto icons = cache.lock())
+    return icons;
+
+  auto icons = std::make_shared<StatusIcons const>();
+
+  cache = icons;
+
+  return icons;
+}
+
+
+unsigned int
+NodeGeometry::
+portWidth(PortType portType) const
+{
+  unsigned width = 0;
+
+  auto const& texts = (portType == PortType::In) ? _inPortTexts : _outPortTexts;
+
+  for (auto const& text : texts)
+  {
+    width = std::max(unsigned(std::ceil(text.size().width())),
                      width);
-#endif
   }
 
   return width;
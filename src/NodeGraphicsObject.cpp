@@ -4,13 +4,13 @@
 #include <cstdlib>
 
 #include <QtWidgets/QtWidgets>
-#include <QtWidgets/QGraphicsEffect>
 
 #include "ConnectionGraphicsObject.hpp"
 #include "ConnectionState.hpp"
 
 #include "FlowScene.hpp"
 #include "NodePainter.hpp"
+#include "ShadowRenderer.hpp"
 
 #include "Node.hpp"
 #include "NodeDataModel.hpp"
@@ -23,7 +23,9 @@
 
 using QtNodes::NodeGraphicsObject;
 using QtNodes::Node;
+using QtNodes::NodeDataModel;
 using QtNodes::FlowScene;
+using QtNodes::ShadowRenderer;
 
 NodeGraphicsObject::
 NodeGraphicsObject(FlowScene &scene,
@@ -35,6 +37,13 @@ NodeGraphicsObject(FlowScene &scene,
   , _possibleGroup(nullptr)
   , _originalGroupSize(QRectF())
   , _proxyWidget(nullptr)
+  , _widgetLive(true)
+  , _widgetSnapshotRevision(0)
+  , _widgetSnapshotTimer(nullptr)
+  , _widgetReleaseTimer(nullptr)
+  , _widgetDetached(false)
+  , _widgetCreationRequested(false)
+  , _movingBatched(false)
 {
   _scene.addItem(this);
 
@@ -48,15 +57,6 @@ NodeGraphicsObject(FlowScene &scene,
 
   auto const &nodeStyle = node.nodeDataModel()->nodeStyle();
 
-  {
-    auto effect = new QGraphicsDropShadowEffect;
-    effect->setOffset(4, 4);
-    effect->setBlurRadius(20);
-    effect->setColor(nodeStyle.ShadowColor);
-
-    setGraphicsEffect(effect);
-  }
-
   setOpacity(nodeStyle.Opacity);
 
   setAcceptHoverEvents(true);
@@ -65,20 +65,25 @@ NodeGraphicsObject(FlowScene &scene,
 
   embedQWidget();
 
-  // connect to the move signals to emit the move signals in FlowScene
-  auto onMoveSlot = [this]
-  {
-    _scene.nodeMoved(_node, pos());
-  };
-  connect(this, &QGraphicsObject::xChanged, this, onMoveSlot);
-  connect(this, &QGraphicsObject::yChanged, this, onMoveSlot);
+  // inputs reach the widget through Node::updateGraphics(), outputs and
+  // resizes through the model
+  connect(node.nodeDataModel(), &NodeDataModel::dataUpdated,
+          this, &NodeGraphicsObject::scheduleWidgetSnapshot);
+  connect(node.nodeDataModel(), &NodeDataModel::embeddedWidgetSizeUpdated,
+          this, &NodeGraphicsObject::scheduleWidgetSnapshot);
 }
 
 
 NodeGraphicsObject::
 ~NodeGraphicsObject()
 {
-  _scene.removeItem(this);
+  // parked items of a virtualized scene are not part of it
+  if (scene() == &_scene)
+    _scene.removeItem(this);
+
+  // the proxy would have deleted the widget along with itself
+  if (_widgetDetached)
+    delete _node.nodeDataModel()->createdEmbeddedWidget();
 }
 
 
@@ -104,7 +109,7 @@ embedQWidget()
 {
   NodeGeometry & geom = _node.nodeGeometry();
 
-  if (auto w = _node.nodeDataModel()->embeddedWidget())
+  if (auto w = _node.nodeDataModel()->createdEmbeddedWidget())
   {
     _proxyWidget = new QGraphicsProxyWidget(this);
 
@@ -126,7 +131,220 @@ embedQWidget()
 
     _proxyWidget->setOpacity(1.0);
     _proxyWidget->setFlag(QGraphicsItem::ItemIgnoresParentOpacity);
+
+    if (_scene.widgetSnapshotsEnabled())
+    {
+      _widgetLive = false;
+      _proxyWidget->setVisible(false);
+
+      scheduleWidgetSnapshot();
+    }
+  }
+}
+
+
+void
+NodeGraphicsObject::
+requestDeferredWidget()
+{
+  if (_widgetCreationRequested || !_node.nodeDataModel()->embeddedWidgetDeferred())
+    return;
+
+  _widgetCreationRequested = true;
+
+  QTimer::singleShot(0, this, &NodeGraphicsObject::createDeferredWidget);
+}
+
+
+void
+NodeGraphicsObject::
+setParked(bool parked)
+{
+  if (parked)
+  {
+    // keep nothing that can be rebuilt once the node is attached again
+    setCacheMode(QGraphicsItem::NoCache);
+    _widgetSnapshot = QPixmap();
+
+    if (!_proxyWidget)
+      return;
+
+    if (_widgetReleaseTimer)
+      _widgetReleaseTimer->stop();
+
+    // detached first, so that the model's widget survives its proxy
+    if (QWidget* w = _proxyWidget->widget())
+    {
+      w->hide();
+      _proxyWidget->setWidget(nullptr);
+      _widgetDetached = true;
+    }
+
+    delete _proxyWidget;
+    _proxyWidget = nullptr;
+    _widgetLive = true;
+  }
+  else
+  {
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+
+    if (!_widgetDetached)
+      return;
+
+    _widgetDetached = false;
+
+    embedQWidget();
+
+    if (_proxyWidget && _widgetLive)
+      _proxyWidget->widget()->show();
+  }
+}
+
+
+void
+NodeGraphicsObject::
+createDeferredWidget()
+{
+  auto model = _node.nodeDataModel();
+
+  // already created, or known not to exist (see createEmbeddedWidget())
+  if (_proxyWidget || !model->embeddedWidgetDeferred() ||
+      model->createdEmbeddedWidget() || model->embeddedWidgetSize().isEmpty())
+    return;
+
+  if (!model->createEmbeddedWidget())
+  {
+    // the node was laid out from the size hint
+    updateGeometry();
+    return;
+  }
+
+  embedQWidget();
+
+  // the widget may not match the size hint it was laid out with
+  updateGeometry();
+}
+
+
+void
+NodeGraphicsObject::
+setWidgetLive(bool live)
+{
+  if (!_proxyWidget)
+    return;
+
+  live = live || !_scene.widgetSnapshotsEnabled();
+
+  if (live == _widgetLive)
+    return;
+
+  // the user may have changed the widget while it was live
+  if (!live)
+    takeWidgetSnapshot();
+
+  _widgetLive = live;
+  _proxyWidget->setVisible(live);
+
+  update();
+}
+
+
+void
+NodeGraphicsObject::
+scheduleWidgetSnapshot()
+{
+  if (!_proxyWidget || _widgetLive)
+    return;
+
+  if (!_widgetSnapshotTimer)
+  {
+    _widgetSnapshotTimer = new QTimer(this);
+    _widgetSnapshotTimer->setSingleShot(true);
+    _widgetSnapshotTimer->setInterval(_widgetSnapshotDelay);
+
+    connect(_widgetSnapshotTimer, &QTimer::timeout, this, [this]
+    {
+      auto w = _node.nodeDataModel()->createdEmbeddedWidget();
+
+      // parked nodes take theirs once attached again
+      if (!w || _widgetLive || scene() != &_scene)
+        return;
+
+      if (_widgetSnapshot.isNull() ||
+          _widgetSnapshotRevision != _node.nodeDataModel()->revision() ||
+          _widgetSnapshot.deviceIndependentSize() != QSizeF(w->size()))
+      {
+        takeWidgetSnapshot();
+        update();
+      }
+    });
+  }
+
+  // not restarted, so that a node updated every frame is still refreshed
+  if (!_widgetSnapshotTimer->isActive())
+    _widgetSnapshotTimer->start();
+}
+
+
+void
+NodeGraphicsObject::
+paintWidgetSnapshot(QPainter* painter)
+{
+  auto w = _node.nodeDataModel()->createdEmbeddedWidget();
+
+  // snapshots are taken by scheduleWidgetSnapshot(), never while painting
+  if (!w || _widgetSnapshot.isNull())
+    return;
+
+  // like the proxy, the snapshot ignores the node's opacity
+  painter->save();
+  painter->setOpacity(1.0);
+  painter->drawPixmap(QRectF(_node.nodeGeometry().widgetPosition(), QSizeF(w->size())),
+                      _widgetSnapshot,
+                      QRectF(_widgetSnapshot.rect()));
+  painter->restore();
+}
+
+
+void
+NodeGraphicsObject::
+takeWidgetSnapshot()
+{
+  if (auto w = _node.nodeDataModel()->createdEmbeddedWidget())
+  {
+    _widgetSnapshot = w->grab();
+    _widgetSnapshotRevision = _node.nodeDataModel()->revision();
+  }
+}
+
+
+void
+NodeGraphicsObject::
+scheduleWidgetRelease()
+{
+  if (!_proxyWidget || !_widgetLive || !_scene.widgetSnapshotsEnabled())
+    return;
+
+  if (!_widgetReleaseTimer)
+  {
+    _widgetReleaseTimer = new QTimer(this);
+    _widgetReleaseTimer->setSingleShot(true);
+    _widgetReleaseTimer->setInterval(_widgetReleaseDelay);
+
+    connect(_widgetReleaseTimer, &QTimer::timeout, this, [this]
+    {
+      // keep the widget live while it's still being used
+      if (isUnderMouse() || _proxyWidget->hasFocus())
+      {
+        _widgetReleaseTimer->start();
+        return;
+      }
+
+      setWidgetLive(false);
+    });
   }
+
+  _widgetReleaseTimer->start();
 }
 
 
@@ -134,7 +352,25 @@ QRectF
 NodeGraphicsObject::
 boundingRect() const
 {
-  return _node.nodeGeometry().boundingRect();
+  auto const& geom = _node.nodeGeometry();
+
+  float diam = _node.nodeDataModel()->nodeStyle().ConnectionPointDiameter;
+
+  QRectF nodeRect(-diam, -diam, 2.0 * diam + geom.width(), 2.0 * diam + geom.height());
+
+  // the drop shadow is painted by the item itself
+  return geom.boundingRect() | ShadowRenderer::shadowRect(nodeRect);
+}
+
+
+QPainterPath
+NodeGraphicsObject::
+shape() const
+{
+  // the shadow is not part of the node as far as picking goes
+  QPainterPath path;
+  path.addRect(_node.nodeGeometry().boundingRect());
+  return path;
 }
 
 
@@ -187,6 +423,99 @@ updateGeometry()
   node().nodeGeometry().recalculateSize();
   moveConnections();
   update();
+  updateGroupBounds();
+
+  _scene.notifyNodeResized(_node);
+}
+
+
+void
+NodeGraphicsObject::
+moveBatched(QPointF const& offset)
+{
+  QSignalBlocker blocker(this);
+
+  _movingBatched = true;
+  moveBy(offset.x(), offset.y());
+  _movingBatched = false;
+}
+
+
+void
+NodeGraphicsObject::
+updateGroupHover(QRectF const& previousSceneRect)
+{
+  if (node().isInGroup())
+    return;
+
+  QRectF const currentSceneRect = sceneBoundingRect();
+
+  auto crossed = [&](QRectF const& area)
+  {
+    return area.intersects(previousSceneRect) != area.intersects(currentSceneRect);
+  };
+
+  bool crossedBorder = _draggingIntoGroup && crossed(_originalGroupSize);
+
+  for (auto const& group : _scene.groups())
+  {
+    if (crossedBorder)
+      break;
+
+    crossedBorder = crossed(group.second->groupGraphicsObject().sceneBoundingRect());
+  }
+
+  if (!crossedBorder)
+    return;
+
+  /// if it intersects with a group, expand group
+  QList<QGraphicsItem*> overlapItems = collidingItems();
+  for (auto& item : overlapItems)
+  {
+    auto ggo = qgraphicsitem_cast<GroupGraphicsObject*>(item);
+    if (ggo != nullptr)
+    {
+      if (!ggo->locked())
+      {
+        if (!_draggingIntoGroup)
+        {
+          _draggingIntoGroup = true;
+          _possibleGroup = ggo;
+          _originalGroupSize = _possibleGroup->mapRectToScene(ggo->rect());
+          _possibleGroup->setPossibleChild(this);
+          break;
+        }
+        else
+        {
+          if (ggo == _possibleGroup)
+          {
+            if (!boundingRect().intersects(mapRectFromScene(_originalGroupSize)))
+            {
+              _draggingIntoGroup = false;
+              _originalGroupSize = QRectF();
+              _possibleGroup->unsetPossibleChild();
+              _possibleGroup = nullptr;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+
+void
+NodeGraphicsObject::
+updateGroupBounds()
+{
+  if (auto nodeGroup = _node.nodeGroup().lock(); nodeGroup)
+  {
+    nodeGroup->groupGraphicsObject().updateChildBounds(*this);
+  }
+  else if (_draggingIntoGroup && _possibleGroup)
+  {
+    _possibleGroup->updateChildBounds(*this);
+  }
 }
 
 
@@ -201,6 +530,9 @@ paint(QPainter * painter,
   painter->setClipRect(option->exposedRect);
 
   NodePainter::paint(painter, _node, _scene);
+
+  if (_proxyWidget && !_widgetLive)
+    paintWidgetSnapshot(painter);
 }
 
 
@@ -208,10 +540,17 @@ QVariant
 NodeGraphicsObject::
 itemChange(GraphicsItemChange change, const QVariant &value)
 {
-  if (change == ItemPositionChange && scene())
+  if (change == ItemPositionChange && scene() && !_movingBatched)
   {
     moveConnections();
   }
+  else if (change == ItemPositionHasChanged && !signalsBlocked())
+  {
+    // sent once per position change, whereas xChanged and yChanged
+    // are both emitted for a diagonal move
+    _scene.notifyNodeMoved(_node, pos());
+    updateGroupBounds();
+  }
 
   return QGraphicsItem::itemChange(change, value);
 }
@@ -226,6 +565,10 @@ mousePressEvent(QGraphicsSceneMouseEvent * event)
     _scene.clearSelection();
     return;
   }
+
+  createDeferredWidget();
+  setWidgetLive(true);
+
   // deselect all other items after this one is selected
   if (!isSelected() &&
       !(event->modifiers() & Qt::ControlModifier))
@@ -249,7 +592,7 @@ mousePressEvent(QGraphicsSceneMouseEvent * event)
     {
       NodeState const & nodeState = _node.nodeState();
 
-      std::unordered_map<QUuid, Connection*> connections =
+      NodeState::ConnectionPtrSet connections =
         nodeState.connections(portToCheck, portIndex);
 
       // start dragging existing connection
@@ -312,7 +655,9 @@ mouseMoveEvent(QGraphicsSceneMouseEvent * event)
   if (state.resizing())
   {
 
-    if (auto w = _node.nodeDataModel()->embeddedWidget())
+    auto w = _node.nodeDataModel()->createdEmbeddedWidget();
+
+    if (w && _proxyWidget)
     {
       prepareGeometryChange();
 
@@ -330,64 +675,35 @@ mouseMoveEvent(QGraphicsSceneMouseEvent * event)
       update();
 
       moveConnections();
+      updateGroupBounds();
 
       event->accept();
     }
   }
-  else
+  else if (auto nodeGroup = node().nodeGroup().lock(); nodeGroup)
   {
     QGraphicsObject::mouseMoveEvent(event);
 
     if (event->lastPos() != event->pos())
     {
-      if (auto nodeGroup = node().nodeGroup().lock(); nodeGroup)
+      nodeGroup->groupGraphicsObject().moveConnections();
+      if (nodeGroup->groupGraphicsObject().locked())
       {
-        nodeGroup->groupGraphicsObject().moveConnections();
-        if (nodeGroup->groupGraphicsObject().locked())
-        {
-          nodeGroup->groupGraphicsObject().moveNodes(diff);
-        }
-      }
-      else
-      {
-        moveConnections();
-        /// if it intersects with a group, expand group
-        QList<QGraphicsItem*> overlapItems = collidingItems();
-        for (auto& item : overlapItems)
-        {
-          auto ggo = qgraphicsitem_cast<GroupGraphicsObject*>(item);
-          if (ggo != nullptr)
-          {
-            if (!ggo->locked())
-            {
-              if (!_draggingIntoGroup)
-              {
-                _draggingIntoGroup = true;
-                _possibleGroup = ggo;
-                _originalGroupSize = _possibleGroup->mapRectToScene(ggo->rect());
-                _possibleGroup->setPossibleChild(this);
-                break;
-              }
-              else
-              {
-                if (ggo == _possibleGroup)
-                {
-                  if (!boundingRect().intersects(mapRectFromScene(_originalGroupSize)))
-                  {
-                    _draggingIntoGroup = false;
-                    _originalGroupSize = QRectF();
-                    _possibleGroup->unsetPossibleChild();
-                    _possibleGroup = nullptr;
-                  }
-                }
-              }
-            }
-          }
-        }
+        nodeGroup->groupGraphicsObject().moveNodes(diff);
       }
     }
     event->ignore();
   }
+  else
+  {
+    // the dragged nodes are moved by the scene once per frame
+    if ((event->buttons() & Qt::LeftButton) && (flags() & ItemIsMovable))
+    {
+      _scene.queueNodeDrag(event->scenePos() - event->lastScenePos());
+    }
+    event->ignore();
+    return;
+  }
   QRectF r = scene()->sceneRect();
 
   r = r.united(mapToScene(boundingRect()).boundingRect());
@@ -404,6 +720,8 @@ mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
 
   state.setResizing(false);
 
+  _scene.flushNodeDrag();
+
   QGraphicsObject::mouseReleaseEvent(event);
 
   // position connections precisely after fast node move
@@ -446,6 +764,12 @@ hoverEnterEvent(QGraphicsSceneHoverEvent * event)
   // bring this node forward
   setZValue(1.0);
 
+  createDeferredWidget();
+  setWidgetLive(true);
+
+  if (_widgetReleaseTimer)
+    _widgetReleaseTimer->stop();
+
   _node.nodeGeometry().setHovered(true);
   update();
   _scene.nodeHovered(node(), event->screenPos());
@@ -459,6 +783,7 @@ hoverLeaveEvent(QGraphicsSceneHoverEvent * event)
 {
   _node.nodeGeometry().setHovered(false);
   update();
+  scheduleWidgetRelease();
   _scene.nodeHoverLeft(node());
   event->accept();
 }
@@ -3,6 +3,7 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 
+#include <algorithm>
 #include <utility>
 
 using QtNodes::GroupGraphicsObject;
@@ -118,6 +119,25 @@ empty() const
   return _childNodes.empty();
 }
 
+void
+NodeGroup::
+setFrozen(bool frozen)
+{
+  for (auto* node : _childNodes)
+  {
+    node->setFrozen(frozen);
+  }
+}
+
+bool
+NodeGroup::
+isFrozen() const
+{
+  return !_childNodes.empty() &&
+         std::all_of(_childNodes.begin(), _childNodes.end(),
+                     [](Node const* node) { return node->isFrozen(); });
+}
+
 int
 NodeGroup::
 groupCount()
@@ -130,6 +150,10 @@ NodeGroup::
 addNode(Node* node)
 {
   _childNodes.push_back(node);
+  if (_groupGraphicsObject)
+  {
+    _groupGraphicsObject->updateBounds();
+  }
 }
 
 void
@@ -141,6 +165,6 @@ removeNode(Node* node)
   {
     (*nodeIt)->unsetNodeGroup();
     _childNodes.erase(nodeIt);
-    groupGraphicsObject().positionLockedIcon();
+    groupGraphicsObject().updateBounds();
   }
 }
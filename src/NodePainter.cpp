@@ -12,6 +12,7 @@
 #include "NodeDataModel.hpp"
 #include "Node.hpp"
 #include "FlowScene.hpp"
+#include "ShadowRenderer.hpp"
 
 using QtNodes::NodePainter;
 using QtNodes::NodeGeometry;
@@ -20,6 +21,8 @@ using QtNodes::Node;
 using QtNodes::NodeState;
 using QtNodes::NodeDataModel;
 using QtNodes::FlowScene;
+using QtNodes::ShadowRenderer;
+using QtNodes::TypeHandle;
 
 void
 NodePainter::
@@ -38,6 +41,8 @@ paint(QPainter* painter,
   //--------------------------------------------
   NodeDataModel const * model = node.nodeDataModel();
 
+  drawNodeShadow(painter, geom, model);
+
   drawNodeRect(painter, geom, model, graphicsObject);
 
   drawConnectionPoints(painter, geom, state, model, scene);
@@ -73,6 +78,22 @@ paint(QPainter* painter,
 }
 
 
+void
+NodePainter::
+drawNodeShadow(QPainter* painter,
+               NodeGeometry const& geom,
+               NodeDataModel const* model)
+{
+  NodeStyle const& nodeStyle = model->nodeStyle();
+
+  float diam = nodeStyle.ConnectionPointDiameter;
+
+  QRectF boundary( -diam, -diam, 2.0 * diam + geom.width(), 2.0 * diam + geom.height());
+
+  ShadowRenderer::drawRoundedRectShadow(painter, boundary, 3.0, nodeStyle.ShadowColor);
+}
+
+
 void
 NodePainter::
 drawNodeRect(QPainter* painter,
@@ -147,6 +168,10 @@ drawConnectionPoints(QPainter* painter,
   float diameter = nodeStyle.ConnectionPointDiameter;
   auto  reducedDiameter = diameter * 0.8;
 
+  TypeHandle const reactingType = state.isReacting() ?
+                                  state.reactingDataType().handle() :
+                                  QtNodes::InvalidTypeHandle;
+
   for(PortType portType:
       {
         PortType::Out, PortType::In
@@ -158,7 +183,7 @@ drawConnectionPoints(QPainter* painter,
     {
       QPointF p = geom.portScenePosition(i, portType);
 
-      auto const & dataType = model->dataType(portType, i);
+      TypeHandle const portTypeHandle = geom.portTypeHandle(portType, i);
 
       bool canConnect = (state.getEntries(portType)[i].empty() ||
                          (portType == PortType::Out &&
@@ -172,20 +197,11 @@ drawConnectionPoints(QPainter* painter,
 
         auto   diff = geom.draggingPos() - p;
         double dist = std::sqrt(QPointF::dotProduct(diff, diff));
-        bool   typeConvertable = false;
-
-        {
-          if (portType == PortType::In)
-          {
-            typeConvertable = scene.registry().getTypeConverter(state.reactingDataType(), dataType) != nullptr;
-          }
-          else
-          {
-            typeConvertable = scene.registry().getTypeConverter(dataType, state.reactingDataType()) != nullptr;
-          }
-        }
+        bool   compatible = (portType == PortType::In) ?
+                                scene.registry().compatible(reactingType, portTypeHandle) :
+                                scene.registry().compatible(portTypeHandle, reactingType);
 
-        if (state.reactingDataType().id == dataType.id || typeConvertable)
+        if (compatible)
         {
           double const thres = 40.0;
           r = (dist < thres) ?
@@ -203,7 +219,7 @@ drawConnectionPoints(QPainter* painter,
 
       if (connectionStyle.useDataDefinedColors())
       {
-        painter->setBrush(connectionStyle.normalColor(dataType.id));
+        painter->setBrush(connectionStyle.normalColor(portTypeHandle));
       }
       else
       {
@@ -243,11 +259,9 @@ drawFilledConnectionPoints(QPainter * painter,
 
       if (!state.getEntries(portType)[i].empty())
       {
-        auto const & dataType = model->dataType(portType, i);
-
         if (connectionStyle.useDataDefinedColors())
         {
-          QColor const c = connectionStyle.normalColor(dataType.id);
+          QColor const& c = connectionStyle.normalColor(geom.portTypeHandle(portType, i));
           painter->setPen(c);
           painter->setBrush(c);
         }
@@ -280,27 +294,27 @@ drawModelName(QPainter * painter,
   if (!model->captionVisible())
     return;
 
-  QString const &name = model->caption();
+  QStaticText const &name = geom.captionText();
 
   QFont font = painter->font();
 
   font.setBold(!model->nicknameVisible());
   font.setItalic(model->nicknameVisible());
 
-  QFontMetrics metrics(font);
+  QSizeF const size = name.size();
 
-  auto rect = metrics.boundingRect(name);
-
-  int nicknameOffset = model->nicknameVisible()? rect.height() : 0;
+  double nicknameOffset = model->nicknameVisible()? size.height() : 0.0;
 
   double yPos = (geom.spacing() + geom.entryHeight() + nicknameOffset) / 3.0;
   if (model->nicknameVisible()) yPos += 2.0 * geom.spacing() / 3.0;
 
-  QPointF position((geom.width() - rect.width()) / 2.0, yPos);
+  // static texts are positioned by their top-left corner, not the baseline
+  QPointF position((geom.width() - size.width()) / 2.0,
+                   yPos - geom.boldTextAscent());
 
   painter->setFont(font);
   painter->setPen(nodeStyle.FontColor);
-  painter->drawText(position, name);
+  painter->drawStaticText(position, name);
 
   font.setBold(false);
   font.setItalic(false);
@@ -318,22 +332,18 @@ drawModelNickname(QPainter * painter,
 
   NodeStyle const& nodeStyle = model->nodeStyle();
 
-  QString const& nickname = model->nickname();
+  QStaticText const& nickname = geom.nicknameText();
 
   QFont font = painter->font();
 
   font.setBold(true);
 
-  QFontMetrics metrics(font);
-
-  auto rect = metrics.boundingRect(nickname);
-
-  QPointF position((geom.width() - rect.width()) / 2.0,
-                   (geom.spacing() + geom.entryHeight()) / 3.0);
+  QPointF position((geom.width() - nickname.size().width()) / 2.0,
+                   (geom.spacing() + geom.entryHeight()) / 3.0 - geom.boldTextAscent());
 
   painter->setFont(font);
   painter->setPen(nodeStyle.FontColor);
-  painter->drawText(position, nickname);
+  painter->drawStaticText(position, nickname);
 
   font.setBold(false);
   painter->setFont(font);
@@ -347,9 +357,6 @@ drawEntryLabels(QPainter * painter,
                 NodeState const & state,
                 NodeDataModel const * model)
 {
-  QFontMetrics const & metrics =
-    painter->fontMetrics();
-
   for (PortType portType: {PortType::Out, PortType::In})
   {
     auto const &nodeStyle = model->nodeStyle();
@@ -367,20 +374,9 @@ drawEntryLabels(QPainter * painter,
       else
         painter->setPen(nodeStyle.FontColor);
 
-      QString s;
-
-      if (model->portCaptionVisible(portType, i))
-      {
-        s = model->portCaption(portType, i);
-      }
-      else
-      {
-        s = model->dataType(portType, i).name;
-      }
-
-      auto rect = metrics.boundingRect(s);
+      QStaticText const& s = geom.portText(portType, i);
 
-      p.setY(p.y() + rect.height() / 4.0);
+      p.setY(p.y() + geom.entryHeight() / 4.0 - geom.textAscent());
 
       switch (portType)
       {
@@ -389,14 +385,14 @@ drawEntryLabels(QPainter * painter,
         break;
 
       case PortType::Out:
-        p.setX(geom.width() - 5.0 - rect.width());
+        p.setX(geom.width() - 5.0 - s.size().width());
         break;
 
       default:
         break;
       }
 
-      painter->drawText(p, s);
+      painter->drawStaticText(p, s);
     }
   }
 }
@@ -469,20 +465,14 @@ drawValidationRect(QPainter * painter,
     painter->setBrush(Qt::gray);
 
     //Drawing the validation message itself
-    QString const &errorMsg = model->validationMessage();
-
-    QFont font = painter->font();
-
-    QFontMetrics metrics(font);
-
-    auto rect = metrics.boundingRect(errorMsg);
+    QStaticText const &errorMsg = geom.validationText();
 
-    QPointF position((geom.width() - rect.width()) / 2.0,
-                     geom.height() - (geom.validationHeight() - diam) / 2.0);
+    QPointF position((geom.width() - errorMsg.size().width()) / 2.0,
+                     geom.height() - (geom.validationHeight() - diam) / 2.0
+                     - geom.textAscent());
 
-    painter->setFont(font);
     painter->setPen(nodeStyle.FontColor);
-    painter->drawText(position, errorMsg);
+    painter->drawStaticText(position, errorMsg);
   }
 }
 
@@ -28,6 +28,12 @@ public:
         Node& node,
         FlowScene const& scene);
 
+  static
+  void
+  drawNodeShadow(QPainter* painter,
+                 NodeGeometry const& geom,
+                 NodeDataModel const* model);
+
   static
   void
   drawNodeRect(QPainter* painter,
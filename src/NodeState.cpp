@@ -61,7 +61,7 @@ setConnection(PortType portType,
 {
   auto &connections = getEntries(portType);
 
-  connections.at(portIndex).insert(std::make_pair(connection.id(),
+  connections.at(portIndex).insert(std::make_pair(connection.objectId(),
                                                &connection));
 }
 
@@ -70,7 +70,7 @@ void
 NodeState::
 eraseConnection(PortType portType,
                 PortIndex portIndex,
-                QUuid id)
+                ObjectId id)
 {
   getEntries(portType)[portIndex].erase(id);
 }
@@ -92,7 +92,7 @@ reactingPortType() const
 }
 
 
-NodeDataType
+NodeDataType const&
 NodeState::
 reactingDataType() const
 {
@@ -111,6 +111,10 @@ setReaction(ReactToConnectionState reaction,
   _reactingPortType = reactingPortType;
 
   _reactingDataType = std::move(reactingDataType);
+
+  // interned once here so that painting the reaction only compares handles
+  if (_reaction == REACTING)
+    _reactingDataType.handle();
 }
 
 
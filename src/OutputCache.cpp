@@ -0,0 +1,233 @@
+#include "OutputCache.hpp"
+
+#include <algorithm>
+
+#include <QtCore/QHash>
+
+using QtNodes::OutputCache;
+using QtNodes::NodeData;
+using QtNodes::ObjectId;
+
+namespace
+{
+
+/// Kinds of input recorded in OutputCache::Key::inputs
+enum InputKind : quint64
+{
+  NoInput       = 0,
+  ContentInput  = 1,
+  IdentityInput = 2,
+};
+}
+
+
+OutputCache::
+OutputCache(std::size_t memoryBudget)
+  : _memoryBudget(memoryBudget)
+{}
+
+
+OutputCache::Key
+OutputCache::
+makeKey(ObjectId node,
+        QByteArray state,
+        std::vector<std::shared_ptr<NodeData>> const& inputs)
+{
+  Key key;
+  key.node  = node;
+  key.state = std::move(state);
+  key.inputs.reserve(2 * inputs.size());
+
+  for (auto const& input : inputs)
+  {
+    if (!input)
+    {
+      key.inputs.push_back(NoInput);
+      key.inputs.push_back(0);
+      continue;
+    }
+
+    quint64 const type = input->typeHandle();
+    quint64 const hash = input->contentHash();
+
+    if (hash != 0)
+    {
+      key.inputs.push_back((ContentInput << 32) | type);
+      key.inputs.push_back(hash);
+    }
+    else
+    {
+      key.inputs.push_back((IdentityInput << 32) | type);
+      key.inputs.push_back(reinterpret_cast<quintptr>(input.get()));
+    }
+  }
+
+  return key;
+}
+
+
+OutputCache::Outputs const*
+OutputCache::
+find(Key const& key)
+{
+  auto it = _index.find(key);
+
+  if (it == _index.end())
+  {
+    ++_misses;
+
+    return nullptr;
+  }
+
+  ++_hits;
+
+  _entries.splice(_entries.begin(), _entries, it->second);
+
+  return &it->second->outputs;
+}
+
+
+void
+OutputCache::
+insert(Key key,
+       Outputs outputs,
+       std::vector<std::shared_ptr<NodeData>> const& inputs)
+{
+  auto existing = _index.find(key);
+
+  if (existing != _index.end())
+  {
+    _memoryUsage -= existing->second->memoryUsage;
+    _entries.erase(existing->second);
+    _index.erase(existing);
+  }
+
+  std::size_t memoryUsage = sizeof(Entry) +
+                            static_cast<std::size_t>(key.state.size()) +
+                            key.inputs.size() * sizeof(quint64);
+
+  for (auto const& output : outputs)
+  {
+    memoryUsage += sizeof(output);
+
+    if (output)
+      memoryUsage += output->memoryUsage();
+  }
+
+  if (memoryUsage > _memoryBudget)
+    return;
+
+  std::vector<std::shared_ptr<NodeData>> pinnedInputs;
+
+  for (auto const& input : inputs)
+  {
+    if (input && input->contentHash() == 0)
+      pinnedInputs.push_back(input);
+  }
+
+  evict(_memoryBudget - memoryUsage);
+
+  _entries.push_front(Entry{key,
+                            std::move(outputs),
+                            std::move(pinnedInputs),
+                            memoryUsage});
+
+  _index.emplace(std::move(key), _entries.begin());
+
+  _memoryUsage += memoryUsage;
+}
+
+
+void
+OutputCache::
+remove(ObjectId node)
+{
+  for (auto it = _entries.begin(); it != _entries.end();)
+  {
+    if (it->key.node == node)
+    {
+      _memoryUsage -= it->memoryUsage;
+      _index.erase(it->key);
+      it = _entries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+
+void
+OutputCache::
+clear()
+{
+  _index.clear();
+  _entries.clear();
+  _memoryUsage = 0;
+}
+
+
+void
+OutputCache::
+setMemoryBudget(std::size_t bytes)
+{
+  _memoryBudget = bytes;
+
+  evict(_memoryBudget);
+}
+
+
+OutputCache::Stats
+OutputCache::
+stats() const
+{
+  Stats stats;
+  stats.hits        = _hits;
+  stats.misses      = _misses;
+  stats.evictions   = _evictions;
+  stats.entries     = _entries.size();
+  stats.memoryUsage = _memoryUsage;
+
+  return stats;
+}
+
+
+void
+OutputCache::
+resetStats()
+{
+  _hits      = 0;
+  _misses    = 0;
+  _evictions = 0;
+}
+
+
+void
+OutputCache::
+evict(std::size_t budget)
+{
+  while (_memoryUsage > budget && !_entries.empty())
+  {
+    Entry const& entry = _entries.back();
+
+    _memoryUsage -= entry.memoryUsage;
+    _index.erase(entry.key);
+    _entries.pop_back();
+
+    ++_evictions;
+  }
+}
+
+
+std::size_t
+OutputCache::KeyHash::
+operator()(Key const& key) const
+{
+  std::size_t seed = qHash(key.node);
+
+  seed = qHashMulti(seed, key.state);
+  seed = qHashRange(key.inputs.begin(), key.inputs.end(), seed);
+
+  return seed;
+}
@@ -0,0 +1,50 @@
+#include "PluginLibrary.hpp"
+
+#include <QtCore/QDebug>
+
+#include "NodeDataModel.hpp"
+
+using QtNodes::PluginLibrary;
+using QtNodes::NodeDataModel;
+using QtNodes::ModelPluginCreateFunction;
+
+PluginLibrary::
+PluginLibrary(QString const& fileName)
+  : _library(fileName)
+{}
+
+
+std::unique_ptr<NodeDataModel>
+PluginLibrary::
+create(QString const& modelName)
+{
+  if (!load())
+    return nullptr;
+
+  return std::unique_ptr<NodeDataModel>(_create(modelName.toUtf8().constData()));
+}
+
+
+bool
+PluginLibrary::
+load()
+{
+  if (_create)
+    return true;
+
+  if (_failed)
+    return false;
+
+  _create = reinterpret_cast<ModelPluginCreateFunction>(
+    _library.resolve(QtNodes::ModelPluginEntryPoint));
+
+  if (!_create)
+  {
+    qWarning() << "Couldn't load model plugin" << _library.fileName()
+               << ":" << _library.errorString();
+
+    _failed = true;
+  }
+
+  return _create != nullptr;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+
+#include <QtCore/QLibrary>
+#include <QtCore/QString>
+
+#include "ModelPlugin.hpp"
+
+namespace QtNodes
+{
+
+class NodeDataModel;
+
+/// Model plugin library, loaded when the first of its models is created.
+class PluginLibrary
+{
+public:
+
+  explicit
+  PluginLibrary(QString const& fileName);
+
+  PluginLibrary(PluginLibrary const&) = delete;
+
+  PluginLibrary&
+  operator=(PluginLibrary const&) = delete;
+
+  /// Loads the library if needed; nullptr if it or the model is unavailable
+  std::unique_ptr<NodeDataModel>
+  create(QString const& modelName);
+
+  bool
+  isLoaded() const
+  {
+    return _create != nullptr;
+  }
+
+private:
+
+  bool
+  load();
+
+private:
+
+  QLibrary _library;
+
+  ModelPluginCreateFunction _create = nullptr;
+
+  /// Set after a failed load, so that it is reported and attempted once
+  bool _failed = false;
+};
+}
@@ -0,0 +1,155 @@
+#include "SceneChanges.hpp"
+
+#include <algorithm>
+
+using QtNodes::SceneChanges;
+using QtNodes::SceneChangeAccumulator;
+
+namespace
+{
+
+template <typename T>
+void
+eraseValue(std::vector<T> & values, T const& value)
+{
+  values.erase(std::remove(values.begin(), values.end(), value), values.end());
+}
+}
+
+
+bool
+SceneChanges::
+empty() const
+{
+  return createdNodes.empty() &&
+         deletedNodes.empty() &&
+         movedNodes.empty() &&
+         updatedNodes.empty() &&
+         createdConnections.empty() &&
+         deletedConnections.empty();
+}
+
+
+void
+SceneChangeAccumulator::
+nodeCreated(QUuid const& id)
+{
+  if (_createdNodes.insert(id).second)
+    _changes.createdNodes.push_back(id);
+}
+
+
+void
+SceneChangeAccumulator::
+nodeDeleted(QUuid const& id)
+{
+  auto moved = _movedIndices.find(id);
+
+  if (moved != _movedIndices.end())
+  {
+    // keep the arrays compact by moving the last entry into the freed slot
+    std::size_t const index = moved->second;
+    std::size_t const last  = _changes.movedNodes.size() - 1;
+
+    if (index != last)
+    {
+      _changes.movedNodes[index]         = _changes.movedNodes[last];
+      _changes.movedNodePositions[index] = _changes.movedNodePositions[last];
+
+      _movedIndices[_changes.movedNodes[index]] = index;
+    }
+
+    _changes.movedNodes.pop_back();
+    _changes.movedNodePositions.pop_back();
+
+    _movedIndices.erase(moved);
+  }
+
+  if (_updatedNodes.erase(id) > 0)
+    eraseValue(_changes.updatedNodes, id);
+
+  // a node created within this frame was never seen by the observers
+  if (_createdNodes.erase(id) > 0)
+  {
+    eraseValue(_changes.createdNodes, id);
+    return;
+  }
+
+  _changes.deletedNodes.push_back(id);
+}
+
+
+void
+SceneChangeAccumulator::
+nodeMoved(QUuid const& id, QPointF const& position)
+{
+  auto moved = _movedIndices.find(id);
+
+  if (moved != _movedIndices.end())
+  {
+    _changes.movedNodePositions[moved->second] = position;
+    return;
+  }
+
+  _movedIndices.emplace(id, _changes.movedNodes.size());
+
+  _changes.movedNodes.push_back(id);
+  _changes.movedNodePositions.push_back(position);
+}
+
+
+void
+SceneChangeAccumulator::
+nodeUpdated(QUuid const& id)
+{
+  if (_updatedNodes.insert(id).second)
+    _changes.updatedNodes.push_back(id);
+}
+
+
+void
+SceneChangeAccumulator::
+connectionCreated(QUuid const& id)
+{
+  if (_createdConnections.insert(id).second)
+    _changes.createdConnections.push_back(id);
+}
+
+
+void
+SceneChangeAccumulator::
+connectionDeleted(QUuid const& id)
+{
+  if (_createdConnections.erase(id) > 0)
+  {
+    eraseValue(_changes.createdConnections, id);
+    return;
+  }
+
+  _changes.deletedConnections.push_back(id);
+}
+
+
+bool
+SceneChangeAccumulator::
+empty() const
+{
+  return _changes.empty();
+}
+
+
+SceneChanges
+SceneChangeAccumulator::
+take()
+{
+  SceneChanges changes = std::move(_changes);
+
+  _changes = SceneChanges();
+
+  _movedIndices.clear();
+  _createdNodes.clear();
+  _updatedNodes.clear();
+  _createdConnections.clear();
+
+  return changes;
+}
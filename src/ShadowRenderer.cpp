@@ -0,0 +1,171 @@
+#include "ShadowRenderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QMargins>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
+#include <QtGui/QPixmapCache>
+#include <QtWidgets/qdrawutil.h>
+
+using QtNodes::ShadowRenderer;
+
+namespace
+{
+
+/// Averages `count` samples spaced by `step` over a window of
+/// 2 * radius + 1 samples, treating everything outside the line as zero.
+void
+boxBlurLine(uchar* line, int count, int step, int radius,
+            std::vector<int> & prefix)
+{
+  prefix.resize(count + 1);
+  prefix[0] = 0;
+
+  for (int i = 0; i < count; ++i)
+    prefix[i + 1] = prefix[i] + line[i * step];
+
+  int const window = 2 * radius + 1;
+
+  for (int i = 0; i < count; ++i)
+  {
+    int const first = std::max(0, i - radius);
+    int const last  = std::min(count, i + radius + 1);
+
+    line[i * step] = static_cast<uchar>((prefix[last] - prefix[first]) / window);
+  }
+}
+
+
+/// Three box blur passes in each direction approximate a gaussian blur
+/// whose visible extent is close to `blurRadius`.
+void
+blurAlphaMask(QImage & mask, int blurRadius)
+{
+  int const boxRadius = std::max(1, blurRadius / 3);
+
+  int const width  = mask.width();
+  int const height = mask.height();
+  int const stride = mask.bytesPerLine();
+
+  uchar* bits = mask.bits();
+
+  std::vector<int> prefix;
+
+  for (int pass = 0; pass < 3; ++pass)
+  {
+    for (int y = 0; y < height; ++y)
+      boxBlurLine(bits + y * stride, width, 1, boxRadius, prefix);
+
+    for (int x = 0; x < width; ++x)
+      boxBlurLine(bits + x, height, stride, boxRadius, prefix);
+  }
+}
+}
+
+
+void
+ShadowRenderer::
+drawRoundedRectShadow(QPainter* painter,
+                      QRectF const& rect,
+                      double radius,
+                      QColor const& color)
+{
+  if (color.alpha() == 0 || rect.isEmpty())
+    return;
+
+  QRect const target = shadowRect(rect).toAlignedRect();
+
+  // Rectangles large enough to contain the whole falloff of every edge are
+  // drawn from one nine-slice image whose margins hold that falloff.
+  int const border = 2 * _blurRadius + static_cast<int>(std::ceil(radius));
+
+  if (target.width() > 2 * border && target.height() > 2 * border)
+  {
+    int const side = 2 * (border - _blurRadius) + 1;
+
+    QPixmap const pixmap = shadowPixmap(QSize(side, side), radius, color);
+
+    qDrawBorderPixmap(painter,
+                      target,
+                      QMargins(border, border, border, border),
+                      pixmap);
+    return;
+  }
+
+  // Small rectangles are prerendered at their bucketed size and stretched.
+  auto bucketed = [](double length)
+  {
+    int const l = static_cast<int>(std::ceil(length));
+
+    return ((l + _sizeBucket - 1) / _sizeBucket) * _sizeBucket;
+  };
+
+  QPixmap const pixmap = shadowPixmap(QSize(bucketed(rect.width()),
+                                            bucketed(rect.height())),
+                                      radius,
+                                      color);
+
+  painter->drawPixmap(QRectF(target), pixmap, QRectF(pixmap.rect()));
+}
+
+
+QRectF
+ShadowRenderer::
+shadowRect(QRectF const& rect)
+{
+  return rect.translated(_offset, _offset)
+         .adjusted(-_blurRadius, -_blurRadius, _blurRadius, _blurRadius);
+}
+
+
+QPixmap
+ShadowRenderer::
+shadowPixmap(QSize const& casterSize,
+             double radius,
+             QColor const& color)
+{
+  QString const key = QStringLiteral("qtnodes_shadow_%1x%2_%3_%4")
+                      .arg(casterSize.width())
+                      .arg(casterSize.height())
+                      .arg(qRound(radius * 10.0))
+                      .arg(color.rgba(), 8, 16, QLatin1Char('0'));
+
+  QPixmap pixmap;
+
+  if (QPixmapCache::find(key, &pixmap))
+    return pixmap;
+
+  QImage mask(casterSize + QSize(2 * _blurRadius, 2 * _blurRadius),
+              QImage::Format_Alpha8);
+  mask.fill(0);
+
+  {
+    QPainter p(&mask);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(Qt::NoPen);
+    p.setBrush(QColor(0, 0, 0, color.alpha()));
+    p.drawRoundedRect(QRectF(QPointF(_blurRadius, _blurRadius), casterSize),
+                      radius, radius);
+  }
+
+  blurAlphaMask(mask, _blurRadius);
+
+  QImage image(mask.size(), QImage::Format_ARGB32_Premultiplied);
+  image.fill(Qt::transparent);
+
+  {
+    QPainter p(&image);
+    p.drawImage(0, 0, mask);
+    p.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    p.fillRect(image.rect(), QColor(color.red(), color.green(), color.blue()));
+  }
+
+  pixmap = QPixmap::fromImage(image);
+
+  QPixmapCache::insert(key, pixmap);
+
+  return pixmap;
+}
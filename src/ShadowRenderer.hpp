@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QtCore/QRectF>
+#include <QtGui/QColor>
+#include <QtGui/QPixmap>
+
+class QPainter;
+
+namespace QtNodes
+{
+
+/// Draws soft drop shadows of rounded rectangles from prerendered, blurred
+/// images. Shadows are cached per size bucket, corner radius and color, and
+/// large rectangles reuse a single nine-slice image regardless of their size.
+class ShadowRenderer
+{
+public:
+
+  /// Paints the shadow cast by `rect`, in the painter's coordinates.
+  static
+  void
+  drawRoundedRectShadow(QPainter* painter,
+                        QRectF const& rect,
+                        double radius,
+                        QColor const& color);
+
+  /// Area covered by the shadow cast by `rect`.
+  static
+  QRectF
+  shadowRect(QRectF const& rect);
+
+private:
+
+  static
+  QPixmap
+  shadowPixmap(QSize const& casterSize,
+               double radius,
+               QColor const& color);
+
+private:
+
+  static constexpr int _blurRadius = 20;
+
+  static constexpr int _offset = 4;
+
+  /// Small shadows are prerendered at their size rounded up to this step.
+  static constexpr int _sizeBucket = 16;
+};
+}
@@ -0,0 +1,185 @@
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using QtNodes::SpatialGrid;
+
+namespace
+{
+
+int
+cellIndex(double coordinate, double cellSize)
+{
+  double const index = std::floor(coordinate / cellSize);
+
+  // the scene rect spans the whole int range; keep far away items in range
+  double const bound = std::numeric_limits<int>::max() / 2;
+
+  return static_cast<int>(std::clamp(index, -bound, bound));
+}
+}
+
+
+SpatialGrid::
+SpatialGrid(double cellSize)
+  : _cellSize(cellSize)
+{}
+
+
+void
+SpatialGrid::
+insert(QGraphicsItem* item, QRectF const& rect)
+{
+  auto it = _rects.find(item);
+
+  if (it != _rects.end())
+  {
+    // moving within the same cells only updates the recorded rect
+    if (!_oversized.count(item) && cellRange(it->second) == cellRange(rect))
+    {
+      it->second = rect;
+      return;
+    }
+
+    unlink(item, it->second);
+  }
+
+  _rects[item] = rect;
+
+  CellRange const range = cellRange(rect);
+
+  if (range.count() > _maxCellsPerItem)
+  {
+    _oversized.insert(item);
+    return;
+  }
+
+  for (int x = range.left; x <= range.right; ++x)
+  {
+    for (int y = range.top; y <= range.bottom; ++y)
+      _cells[cellKey(x, y)].push_back(item);
+  }
+}
+
+
+void
+SpatialGrid::
+remove(QGraphicsItem* item)
+{
+  auto it = _rects.find(item);
+
+  if (it == _rects.end())
+    return;
+
+  unlink(item, it->second);
+
+  _rects.erase(it);
+}
+
+
+void
+SpatialGrid::
+clear()
+{
+  _cells.clear();
+  _rects.clear();
+  _oversized.clear();
+}
+
+
+void
+SpatialGrid::
+query(QRectF const& area,
+      std::unordered_set<QGraphicsItem*>& result) const
+{
+  auto test = [&](QGraphicsItem* item)
+  {
+    if (_rects.at(item).intersects(area))
+      result.insert(item);
+  };
+
+  for (QGraphicsItem* item : _oversized)
+    test(item);
+
+  CellRange const range = cellRange(area);
+
+  // a zoomed out view may cover more cells than are occupied
+  if (range.count() > qint64(_cells.size()))
+  {
+    for (auto const& cell : _cells)
+    {
+      int const x = static_cast<int>(quint32(cell.first >> 32));
+      int const y = static_cast<int>(quint32(cell.first));
+
+      if (x < range.left || x > range.right || y < range.top || y > range.bottom)
+        continue;
+
+      for (QGraphicsItem* item : cell.second)
+        test(item);
+    }
+
+    return;
+  }
+
+  for (int x = range.left; x <= range.right; ++x)
+  {
+    for (int y = range.top; y <= range.bottom; ++y)
+    {
+      auto cell = _cells.find(cellKey(x, y));
+
+      if (cell == _cells.end())
+        continue;
+
+      for (QGraphicsItem* item : cell->second)
+        test(item);
+    }
+  }
+}
+
+
+SpatialGrid::CellRange
+SpatialGrid::
+cellRange(QRectF const& rect) const
+{
+  return { cellIndex(rect.left(), _cellSize),
+           cellIndex(rect.top(), _cellSize),
+           cellIndex(rect.right(), _cellSize),
+           cellIndex(rect.bottom(), _cellSize) };
+}
+
+
+void
+SpatialGrid::
+unlink(QGraphicsItem* item, QRectF const& rect)
+{
+  if (_oversized.erase(item))
+    return;
+
+  CellRange const range = cellRange(rect);
+
+  for (int x = range.left; x <= range.right; ++x)
+  {
+    for (int y = range.top; y <= range.bottom; ++y)
+    {
+      auto cell = _cells.find(cellKey(x, y));
+
+      if (cell == _cells.end())
+        continue;
+
+      auto & items = cell->second;
+
+      auto found = std::find(items.begin(), items.end(), item);
+
+      if (found != items.end())
+      {
+        *found = items.back();
+        items.pop_back();
+      }
+
+      if (items.empty())
+        _cells.erase(cell);
+    }
+  }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QtCore/QRectF>
+#include <QtCore/QtGlobal>
+
+class QGraphicsItem;
+
+namespace QtNodes
+{
+
+/// Uniform grid over the scene bounding rects of graphics items, used to find
+/// the items intersecting an area without visiting every item of the scene.
+/// Items record the rect they were inserted with; it is only refreshed when
+/// they are inserted again.
+class SpatialGrid
+{
+public:
+
+  explicit
+  SpatialGrid(double cellSize);
+
+  SpatialGrid(SpatialGrid const&) = delete;
+
+  SpatialGrid&
+  operator=(SpatialGrid const&) = delete;
+
+  /// Inserts `item`, or moves it if it was already part of the grid.
+  void
+  insert(QGraphicsItem* item, QRectF const& rect);
+
+  void
+  remove(QGraphicsItem* item);
+
+  void
+  clear();
+
+  /// Adds the items whose recorded rect intersects `area` to `result`.
+  void
+  query(QRectF const& area,
+        std::unordered_set<QGraphicsItem*>& result) const;
+
+private:
+
+  struct CellRange
+  {
+    int left;
+    int top;
+    int right;
+    int bottom;
+
+    qint64
+    count() const
+    {
+      return qint64(right - left + 1) * qint64(bottom - top + 1);
+    }
+
+    bool
+    operator==(CellRange const& other) const
+    {
+      return left == other.left && top == other.top &&
+             right == other.right && bottom == other.bottom;
+    }
+  };
+
+  CellRange
+  cellRange(QRectF const& rect) const;
+
+  static
+  quint64
+  cellKey(int x, int y)
+  {
+    return (quint64(quint32(x)) << 32) | quint32(y);
+  }
+
+  void
+  unlink(QGraphicsItem* item, QRectF const& rect);
+
+private:
+
+  double _cellSize;
+
+  std::unordered_map<quint64, std::vector<QGraphicsItem*>> _cells;
+
+  std::unordered_map<QGraphicsItem*, QRectF> _rects;
+
+  /// Items spanning too many cells to be spread over them, such as long
+  /// connections; they are tested against every query.
+  std::unordered_set<QGraphicsItem*> _oversized;
+
+  /// Items covering more cells than this are kept in _oversized.
+  static constexpr qint64 _maxCellsPerItem{64};
+};
+}
@@ -1,18 +1,99 @@
 #include "StyleCollection.hpp"
 
+#include <algorithm>
+
 using QtNodes::StyleCollection;
 using QtNodes::NodeStyle;
 using QtNodes::ConnectionStyle;
 using QtNodes::FlowViewStyle;
 
+namespace
+{
+
+bool
+sameNodeStyle(NodeStyle const& a, NodeStyle const& b)
+{
+  return a.NormalBoundaryColor == b.NormalBoundaryColor &&
+         a.SelectedBoundaryColor == b.SelectedBoundaryColor &&
+         a.GradientColor0 == b.GradientColor0 &&
+         a.GradientColor1 == b.GradientColor1 &&
+         a.GradientColor2 == b.GradientColor2 &&
+         a.GradientColor3 == b.GradientColor3 &&
+         a.SelectedGradientColor0 == b.SelectedGradientColor0 &&
+         a.SelectedGradientColor1 == b.SelectedGradientColor1 &&
+         a.SelectedGradientColor2 == b.SelectedGradientColor2 &&
+         a.SelectedGradientColor3 == b.SelectedGradientColor3 &&
+         a.ShadowColor == b.ShadowColor &&
+         a.FontColor == b.FontColor &&
+         a.FontColorFaded == b.FontColorFaded &&
+         a.ConnectionPointColor == b.ConnectionPointColor &&
+         a.FilledConnectionPointColor == b.FilledConnectionPointColor &&
+         a.WarningColor == b.WarningColor &&
+         a.ErrorColor == b.ErrorColor &&
+         a.PenWidth == b.PenWidth &&
+         a.HoveredPenWidth == b.HoveredPenWidth &&
+         a.ConnectionPointDiameter == b.ConnectionPointDiameter &&
+         a.Opacity == b.Opacity;
+}
+}
+
+
+StyleCollection::
+StyleCollection()
+  : _nodeStyle(std::make_shared<NodeStyle>())
+{
+}
+
+
 NodeStyle const&
 StyleCollection::
 nodeStyle()
+{
+  return *instance()._nodeStyle;
+}
+
+
+std::shared_ptr<NodeStyle const>
+StyleCollection::
+sharedNodeStyle()
 {
   return instance()._nodeStyle;
 }
 
 
+std::shared_ptr<NodeStyle const>
+StyleCollection::
+sharedNodeStyle(NodeStyle const& style)
+{
+  // models are only styled from the GUI thread
+  auto & collection = instance();
+
+  if (sameNodeStyle(style, *collection._nodeStyle))
+    return collection._nodeStyle;
+
+  auto & custom = collection._customNodeStyles;
+
+  custom.erase(std::remove_if(custom.begin(), custom.end(),
+                              [](std::weak_ptr<NodeStyle const> const& entry)
+                              { return entry.expired(); }),
+               custom.end());
+
+  for (auto const& entry : custom)
+  {
+    auto shared = entry.lock();
+
+    if (shared && sameNodeStyle(style, *shared))
+      return shared;
+  }
+
+  auto shared = std::make_shared<NodeStyle const>(style);
+
+  custom.push_back(shared);
+
+  return shared;
+}
+
+
 ConnectionStyle const&
 StyleCollection::
 connectionStyle()
@@ -33,7 +114,9 @@ void
 StyleCollection::
 setNodeStyle(NodeStyle nodeStyle)
 {
-  instance()._nodeStyle = nodeStyle;
+  // assigned in place: models still using the default follow the new style and
+  // references handed out by nodeStyle() stay valid
+  *instance()._nodeStyle = std::move(nodeStyle);
 }
 
 
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <memory>
+
+#include <nodes/Node>
+#include <nodes/NodeData>
+#include <nodes/TypedNodeDataModel>
+
+/// Integer data with a content hash, so that caches recognize equal values
+class ValueData : public QtNodes::NodeData
+{
+public:
+
+  explicit
+  ValueData(int value)
+    : _value(value)
+  {}
+
+  static QtNodes::NodeDataType staticType()
+  {
+    return QtNodes::NodeDataType {"test-value", "Value"};
+  }
+
+  QtNodes::NodeDataType type() const override
+  { return staticType(); }
+
+  QtNodes::TypeHandle typeHandle() const override
+  { return QtNodes::staticTypeHandle<ValueData>(); }
+
+  quint64 contentHash() const override
+  { return static_cast<quint64>(_value) + 1; }
+
+  std::size_t memoryUsage() const override
+  { return sizeof(*this); }
+
+  int value() const
+  { return _value; }
+
+private:
+
+  int _value;
+};
+
+
+/// Doubles its input and counts how many times it did so
+class DoublingModel
+  : public QtNodes::TypedNodeDataModel<QtNodes::Inputs<ValueData>,
+                                       QtNodes::Outputs<ValueData>>
+{
+public:
+
+  QString caption() const override { return QStringLiteral("Double"); }
+
+  QString progressValue() const override { return QString(); }
+
+  QString name() const override { return QStringLiteral("Double"); }
+
+  QString nickname() const override { return QString(); }
+
+  QWidget* embeddedWidget() override { return nullptr; }
+
+  void
+  setTypedInData(std::shared_ptr<ValueData> data, QtNodes::InPort<0>) override
+  {
+    ++computations;
+
+    if (data)
+      _result = std::make_shared<ValueData>(2 * data->value());
+    else
+      _result.reset();
+
+    Q_EMIT dataUpdated(0);
+  }
+
+  std::shared_ptr<ValueData>
+  typedOutData(QtNodes::OutPort<0>) override
+  {
+    return _result;
+  }
+
+  int computations = 0;
+
+private:
+
+  std::shared_ptr<ValueData> _result;
+};
+
+
+/// Value of the given data, or -1 if it is null or not a ValueData
+inline int
+valueOf(std::shared_ptr<QtNodes::NodeData> const& data)
+{
+  auto value = std::dynamic_pointer_cast<ValueData>(data);
+
+  return value ? value->value() : -1;
+}
+
+
+inline int
+outputValue(QtNodes::Node const& node)
+{
+  return valueOf(node.outData(0));
+}
+
+
+inline int
+outputValue(QtNodes::NodeDataModel& model)
+{
+  return valueOf(model.outData(0));
+}
+
+
+/// Computations of a node whose model is a DoublingModel
+inline int
+computations(QtNodes::Node const& node)
+{
+  return static_cast<DoublingModel*>(node.nodeDataModel())->computations;
+}
@@ -0,0 +1,21 @@
+#include <nodes/ModelPlugin>
+
+#include <QtCore/QtGlobal>
+
+#include "StubNodeDataModel.hpp"
+
+/// Model plugin used by the plugin tests of DataModelRegistry, providing
+/// the models "PluginModelA" and "PluginModelB".
+extern "C" Q_DECL_EXPORT QtNodes::NodeDataModel*
+qtnodes_create_model(char const* modelName)
+{
+  QString const name = QString::fromUtf8(modelName);
+
+  if (name != "PluginModelA" && name != "PluginModelB")
+    return nullptr;
+
+  auto model = new StubNodeDataModel();
+  model->name(name);
+
+  return model;
+}
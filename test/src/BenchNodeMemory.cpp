@@ -0,0 +1,114 @@
+#include <nodes/FlowScene>
+#include <nodes/Node>
+#include <nodes/NodeDataModel>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QFile>
+
+#include <cstddef>
+#include <iostream>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+#include "ApplicationSetup.hpp"
+#include "StubNodeDataModel.hpp"
+
+using QtNodes::FlowScene;
+using QtNodes::Node;
+using QtNodes::NodeDataModel;
+using QtNodes::NodeGeometry;
+using QtNodes::NodeStyle;
+
+namespace
+{
+
+/// Resident set size of the process in bytes, or 0 where it can't be read.
+std::size_t
+residentMemory()
+{
+#ifndef Q_OS_UNIX
+  return 0;
+#else
+  QFile statm(QStringLiteral("/proc/self/statm"));
+
+  if (!statm.open(QIODevice::ReadOnly))
+    return 0;
+
+  QList<QByteArray> const fields = statm.readAll().split(' ');
+
+  if (fields.size() < 2)
+    return 0;
+
+  long const pageSize = sysconf(_SC_PAGESIZE);
+
+  if (pageSize <= 0)
+    return 0;
+
+  // the second field is the resident size, in pages
+  return fields[1].toULongLong() * static_cast<std::size_t>(pageSize);
+#endif
+}
+}
+
+
+TEST_CASE("Memory per node", "[.][benchmark]")
+{
+  auto setup = applicationSetup();
+
+  std::size_t const nodeCount = 100000;
+
+  std::cout << "sizeof(NodeGeometry): " << sizeof(NodeGeometry) << " B\n"
+            << "sizeof(NodeStyle):    " << sizeof(NodeStyle) << " B\n";
+
+  auto report = [&](char const* label, std::size_t before, std::size_t after)
+  {
+    if (before == 0 || after < before)
+    {
+      std::cout << label << ": resident memory not available\n";
+      return;
+    }
+
+    std::cout << label << ": "
+              << (after - before) / nodeCount << " B/node over "
+              << nodeCount << " nodes\n";
+  };
+
+  SECTION("default style")
+  {
+    FlowScene scene;
+
+    std::size_t const before = residentMemory();
+
+    for (std::size_t i = 0; i < nodeCount; ++i)
+      scene.createNode(std::make_unique<StubNodeDataModel>());
+
+    report("default style", before, residentMemory());
+
+    CHECK(scene.nodes().size() == nodeCount);
+  }
+
+  SECTION("customized style")
+  {
+    FlowScene scene;
+
+    NodeStyle style;
+    style.Opacity = 0.5f;
+
+    std::size_t const before = residentMemory();
+
+    for (std::size_t i = 0; i < nodeCount; ++i)
+    {
+      auto model = std::make_unique<StubNodeDataModel>();
+      model->setNodeStyle(style);
+
+      scene.createNode(std::move(model));
+    }
+
+    report("customized style", before, residentMemory());
+
+    CHECK(scene.nodes().size() == nodeCount);
+  }
+}
@@ -0,0 +1,289 @@
+#include <nodes/AsyncNodeDataModel>
+#include <nodes/ComputeScheduler>
+#include <nodes/FlowScene>
+#include <nodes/Node>
+#include <nodes/OutputCache>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+#include <atomic>
+
+#include "ApplicationSetup.hpp"
+#include "DoublingModel.hpp"
+
+using QtNodes::AsyncNodeDataModel;
+using QtNodes::CancellationToken;
+using QtNodes::ComputeScheduler;
+using QtNodes::FlowScene;
+using QtNodes::Node;
+using QtNodes::NodeDataModel;
+using QtNodes::NodeDataType;
+using QtNodes::NodeProcessingStatus;
+using QtNodes::OutputCache;
+using QtNodes::PortIndex;
+using QtNodes::PortType;
+
+namespace
+{
+
+std::atomic<int> running{0};
+std::atomic<int> maxRunning{0};
+std::atomic<int> cancelled{0};
+
+
+/// Doubles its input after a while, unless cancelled in the meantime
+class SlowDoublingModel : public AsyncNodeDataModel
+{
+public:
+
+  QString caption() const override { return QStringLiteral("Slow Double"); }
+
+  QString progressValue() const override { return QString(); }
+
+  QString name() const override { return QStringLiteral("SlowDouble"); }
+
+  QString nickname() const override { return QString(); }
+
+  QWidget* embeddedWidget() override { return nullptr; }
+
+  unsigned int
+  nPorts(PortType) const override
+  {
+    return 1;
+  }
+
+  NodeDataType
+  dataType(PortType, PortIndex) const override
+  {
+    return ValueData::staticType();
+  }
+
+protected:
+
+  Outputs
+  compute(Inputs inputs, CancellationToken token) const override
+  {
+    int const count = ++running;
+
+    int max = maxRunning;
+    while (count > max && !maxRunning.compare_exchange_weak(max, count))
+    {}
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!token.isCancelled() && timer.elapsed() < 20)
+      QThread::msleep(1);
+
+    --running;
+
+    if (token.isCancelled())
+    {
+      ++cancelled;
+      return {};
+    }
+
+    auto input = std::static_pointer_cast<ValueData>(inputs[0]);
+
+    return {std::make_shared<ValueData>(2 * input->value())};
+  }
+};
+
+
+std::atomic<int> started{0};
+std::atomic<bool> destroyed{false};
+std::atomic<int> usedAfterDestruction{0};
+
+
+/// Computes until cancelled, then checks it hasn't outlived its model
+class BlockingModel : public SlowDoublingModel
+{
+public:
+
+  ~BlockingModel() override
+  {
+    destroyed = true;
+  }
+
+protected:
+
+  Outputs
+  compute(Inputs, CancellationToken token) const override
+  {
+    ++started;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!token.isCancelled() && timer.elapsed() < 5000)
+      QThread::msleep(1);
+
+    if (destroyed)
+      ++usedAfterDestruction;
+
+    return {};
+  }
+};
+
+
+void
+waitForJobs(ComputeScheduler& scheduler)
+{
+  REQUIRE(scheduler.waitForDone(5000));
+
+  // results are delivered through the event loop
+  QCoreApplication::processEvents();
+}
+}
+
+
+TEST_CASE("AsyncNodeDataModel delivers the latest result only", "[interface]")
+{
+  auto setup = applicationSetup();
+
+  auto scheduler = std::make_shared<ComputeScheduler>(1);
+
+  SlowDoublingModel model;
+  model.setScheduler(scheduler);
+
+  QSignalSpy updates(&model, &NodeDataModel::dataUpdated);
+
+  cancelled = 0;
+
+  model.setInData(std::make_shared<ValueData>(1), 0);
+
+  CHECK(model.processingStatus() == NodeProcessingStatus::Pending);
+
+  model.setInData(std::make_shared<ValueData>(2), 0);
+
+  waitForJobs(*scheduler);
+
+  CHECK(model.generation() == 2);
+  CHECK(updates.count() == 1);
+  CHECK(outputValue(model) == 4);
+  CHECK(model.processingStatus() == NodeProcessingStatus::Updated);
+
+  SECTION("missing inputs reset the outputs without computing")
+  {
+    model.setInData(nullptr, 0);
+
+    CHECK(updates.count() == 2);
+    CHECK(outputValue(model) == -1);
+    CHECK(model.processingStatus() == NodeProcessingStatus::Empty);
+  }
+}
+
+
+TEST_CASE("Removing a node stops its computation first", "[interface]")
+{
+  auto setup = applicationSetup();
+
+  auto scheduler = std::make_shared<ComputeScheduler>(1);
+
+  FlowScene scene;
+
+  auto& busy    = scene.createNode(std::make_unique<BlockingModel>());
+  auto& waiting = scene.createNode(std::make_unique<BlockingModel>());
+
+  for (Node* node : {&busy, &waiting})
+    static_cast<AsyncNodeDataModel*>(node->nodeDataModel())->setScheduler(scheduler);
+
+  started = 0;
+  destroyed = false;
+  usedAfterDestruction = 0;
+
+  busy.propagateData(std::make_shared<ValueData>(1), 0);
+
+  REQUIRE(QTest::qWaitFor([] { return started == 1; }, 5000));
+
+  // the only worker is busy, so this job waits in the queue
+  waiting.propagateData(std::make_shared<ValueData>(2), 0);
+
+  scene.removeNode(waiting);
+
+  // only the busy model's destruction matters from here on
+  destroyed = false;
+
+  scene.removeNode(busy);
+
+  REQUIRE(scheduler->waitForDone(5000));
+
+  CHECK(started == 1);
+  CHECK(usedAfterDestruction == 0);
+}
+
+
+TEST_CASE("Results of outdated inputs don't reach the output cache", "[interface]")
+{
+  auto setup = applicationSetup();
+
+  auto scheduler = std::make_shared<ComputeScheduler>(1);
+  auto cache     = std::make_shared<OutputCache>();
+
+  FlowScene scene;
+
+  auto& node  = scene.createNode(std::make_unique<SlowDoublingModel>());
+  auto* model = static_cast<SlowDoublingModel*>(node.nodeDataModel());
+
+  model->setScheduler(scheduler);
+  node.setOutputCache(cache);
+
+  node.propagateData(std::make_shared<ValueData>(1), 0);
+
+  REQUIRE(QTest::qWaitFor([&] { return cache->stats().entries == 1; }, 5000));
+  REQUIRE(outputValue(node) == 2);
+
+  // the cache answers for 1 while the model still computes 2
+  node.propagateData(std::make_shared<ValueData>(2), 0);
+  node.propagateData(std::make_shared<ValueData>(1), 0);
+
+  CHECK(outputValue(node) == 2);
+
+  // the result for 2 is dropped, and the model computes 1 again
+  REQUIRE(QTest::qWaitFor([&]
+  {
+    return model->generation() == 3 &&
+           model->processingStatus() == NodeProcessingStatus::Updated;
+  }, 5000));
+
+  QCoreApplication::processEvents();
+
+  CHECK(outputValue(node) == 2);
+  CHECK(cache->stats().entries == 1);
+
+  node.propagateData(std::make_shared<ValueData>(1), 0);
+
+  CHECK(outputValue(node) == 2);
+  CHECK(cache->stats().hits == 2);
+}
+
+
+TEST_CASE("ComputeScheduler caps concurrent jobs", "[interface]")
+{
+  auto setup = applicationSetup();
+
+  auto scheduler = std::make_shared<ComputeScheduler>(2);
+
+  std::vector<std::unique_ptr<SlowDoublingModel>> models;
+
+  maxRunning = 0;
+
+  for (int i = 0; i < 6; ++i)
+  {
+    models.push_back(std::make_unique<SlowDoublingModel>());
+    models.back()->setScheduler(scheduler);
+    models.back()->setInData(std::make_shared<ValueData>(i), 0);
+  }
+
+  waitForJobs(*scheduler);
+
+  CHECK(maxRunning <= 2);
+
+  for (int i = 0; i < 6; ++i)
+    CHECK(outputValue(*models[i]) == 2 * i);
+}
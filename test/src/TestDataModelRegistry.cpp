@@ -2,9 +2,22 @@
 
 #include <catch2/catch.hpp>
 
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QLibrary>
+#include <QtCore/QTemporaryDir>
+
+#include <iostream>
+
 #include "StubNodeDataModel.hpp"
 
 using QtNodes::DataModelRegistry;
+using QtNodes::ModelDescriptor;
 using QtNodes::NodeData;
 using QtNodes::NodeDataModel;
 using QtNodes::NodeDataType;
@@ -22,6 +35,28 @@ public:
     return "Name";
   }
 };
+
+/// Counts its instances, to tell whether registration constructed it
+class StubModelWithDescriptor : public StubNodeDataModel
+{
+public:
+  StubModelWithDescriptor()
+  {
+    ++constructed;
+  }
+
+  static ModelDescriptor
+  Descriptor()
+  {
+    return ModelDescriptor{"Described", "", "Described model",
+                           {NodeDataType{"test-descriptor-in", "In"}},
+                           {}};
+  }
+
+  static int constructed;
+};
+
+int StubModelWithDescriptor::constructed = 0;
 }
 
 TEST_CASE("DataModelRegistry::registerModel", "[interface]")
@@ -70,3 +105,154 @@ TEST_CASE("DataModelRegistry::registerModel", "[interface]")
     }
   }
 }
+
+
+TEST_CASE("DataModelRegistry registers models from descriptors", "[interface]")
+{
+  DataModelRegistry registry;
+
+  StubModelWithDescriptor::constructed = 0;
+
+  SECTION("static Descriptor()")
+  {
+    registry.registerModel<StubModelWithDescriptor>("Category");
+
+    CHECK(StubModelWithDescriptor::constructed == 0);
+    CHECK(registry.registeredModelsCategoryAssociation().at("Described") == "Category");
+
+    ModelDescriptor const* descriptor = registry.descriptor("Described");
+    REQUIRE(descriptor != nullptr);
+    CHECK(descriptor->caption == "Described model");
+    CHECK(descriptor->inputs.size() == 1);
+
+    auto model = registry.create("Described");
+
+    CHECK(model != nullptr);
+    CHECK(StubModelWithDescriptor::constructed == 1);
+  }
+
+  SECTION("explicit descriptor")
+  {
+    ModelDescriptor descriptor;
+    descriptor.name = "Explicit";
+
+    registry.registerModel(descriptor, [] {
+      return std::make_unique<StubModelWithDescriptor>();
+    });
+
+    CHECK(StubModelWithDescriptor::constructed == 0);
+    CHECK(registry.categories().count("Nodes") == 1);
+    REQUIRE(registry.descriptor("Explicit") != nullptr);
+    CHECK(registry.descriptor("Explicit")->caption == "Explicit");
+    CHECK(registry.descriptor("name") == nullptr);
+  }
+}
+
+
+TEST_CASE("DataModelRegistry registers plugin manifests", "[interface]")
+{
+  DataModelRegistry registry;
+
+  QJsonObject const manifest = QJsonDocument::fromJson(R"(
+  {
+    "library": "test-missing-plugin",
+    "models": [
+      {
+        "name": "PluginModel",
+        "category": "Plugins",
+        "inputs":  [ { "id": "test-plugin-in", "name": "In" } ],
+        "outputs": [ { "id": "test-plugin-out", "name": "Out" } ]
+      }
+    ]
+  })").object();
+
+  REQUIRE(registry.registerPlugin(manifest, "."));
+
+  CHECK(registry.categories().count("Plugins") == 1);
+
+  ModelDescriptor const* descriptor = registry.descriptor("PluginModel");
+  REQUIRE(descriptor != nullptr);
+  CHECK(descriptor->caption == "PluginModel");
+  REQUIRE(descriptor->outputs.size() == 1);
+  CHECK(descriptor->outputs[0].id == "test-plugin-out");
+
+  // the library is only looked for now, and its absence is not fatal
+  CHECK(registry.create("PluginModel") == nullptr);
+
+  CHECK(!registry.registerPlugin(QJsonObject(), "."));
+}
+
+
+TEST_CASE("DataModelRegistry loads a plugin library on first use", "[interface]")
+{
+  // a private copy of the plugin, so that no other test has loaded it and it
+  // can be renamed away once in use
+  QTemporaryDir directory;
+  REQUIRE(directory.isValid());
+
+  QString const libraryName =
+    QStringLiteral("copy-") + QFileInfo(TEST_MODEL_PLUGIN_FILE).fileName();
+  QString const libraryFile = QDir(directory.path()).filePath(libraryName);
+
+  REQUIRE(QFile::copy(TEST_MODEL_PLUGIN_FILE, libraryFile));
+
+  QJsonObject manifest;
+  manifest["library"] = libraryName;
+  manifest["models"]  = QJsonArray{ QJsonObject{ { "name", "PluginModelA" } },
+                                    QJsonObject{ { "name", "PluginModelB" } } };
+
+  DataModelRegistry registry;
+  REQUIRE(registry.registerPlugin(manifest, directory.path()));
+
+  // QLibrary instances share the load state of their file
+  CHECK(!QLibrary(libraryFile).isLoaded());
+
+  auto modelA = registry.create("PluginModelA");
+
+  // created through the resolved qtnodes_create_model
+  REQUIRE(modelA != nullptr);
+  CHECK(modelA->name() == "PluginModelA");
+  CHECK(QLibrary(libraryFile).isLoaded());
+
+  // the second model can only be created by the library loaded for the
+  // first one, as the file is gone from the manifest's location
+  REQUIRE(QFile::rename(libraryFile, libraryFile + ".moved"));
+
+  auto modelB = registry.create("PluginModelB");
+
+  REQUIRE(modelB != nullptr);
+  CHECK(modelB->name() == "PluginModelB");
+}
+
+
+TEST_CASE("Registering many models", "[.][benchmark]")
+{
+  int const modelCount = 1000;
+
+  StubModelWithDescriptor::constructed = 0;
+
+  QElapsedTimer timer;
+  timer.start();
+
+  DataModelRegistry registry;
+
+  for (int i = 0; i < modelCount; ++i)
+  {
+    ModelDescriptor descriptor;
+    descriptor.name     = QStringLiteral("Model %1").arg(i);
+    descriptor.category = QStringLiteral("Category %1").arg(i % 20);
+    descriptor.inputs   = {NodeDataType{"test-bench-in", "In"}};
+    descriptor.outputs  = {NodeDataType{"test-bench-out", "Out"}};
+
+    registry.registerModel(std::move(descriptor), [] {
+      return std::make_unique<StubModelWithDescriptor>();
+    });
+  }
+
+  std::cout << "registered " << modelCount << " models in "
+            << timer.nsecsElapsed() / 1000 << " us, "
+            << StubModelWithDescriptor::constructed << " constructed\n";
+
+  CHECK(registry.registeredModelCreators().size() == std::size_t(modelCount));
+  CHECK(StubModelWithDescriptor::constructed == 0);
+}
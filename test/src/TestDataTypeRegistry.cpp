@@ -0,0 +1,119 @@
+#include <nodes/DataModelRegistry>
+#include <nodes/DataTypeRegistry>
+#include <nodes/ConnectionStyle>
+
+#include <catch2/catch.hpp>
+
+using QtNodes::ConnectionStyle;
+using QtNodes::DataModelRegistry;
+using QtNodes::NodeData;
+using QtNodes::NodeDataType;
+using QtNodes::DataTypeRegistry;
+using QtNodes::TypeHandle;
+
+TEST_CASE("DataTypeRegistry interns type ids", "[interface]")
+{
+  TypeHandle const a = DataTypeRegistry::handle("test-type-a");
+  TypeHandle const b = DataTypeRegistry::handle("test-type-b");
+
+  CHECK(a != b);
+  CHECK(DataTypeRegistry::handle("test-type-a") == a);
+  CHECK(DataTypeRegistry::typeId(b) == "test-type-b");
+  CHECK(DataTypeRegistry::size() > b);
+}
+
+TEST_CASE("ConnectionStyle resolves data-defined colors per type", "[interface]")
+{
+  ConnectionStyle style(R"(
+  {
+    "ConnectionStyle": {
+      "UseDataDefinedColors": true,
+      "DataTypeColors": {
+        "test-type-colored": [10, 20, 30]
+      }
+    }
+  }
+  )");
+
+  SECTION("explicit override")
+  {
+    TypeHandle const h = DataTypeRegistry::handle("test-type-colored");
+
+    CHECK(style.normalColor(h) == QColor(10, 20, 30));
+    CHECK(style.normalColor(QString("test-type-colored")) == QColor(10, 20, 30));
+  }
+  SECTION("generated color is stable")
+  {
+    TypeHandle const h = DataTypeRegistry::handle("test-type-generated");
+
+    QColor const first = style.normalColor(h);
+
+    CHECK(first.isValid());
+    CHECK(style.normalColor(h) == first);
+    CHECK(ConnectionStyle().normalColor(h) == first);
+  }
+}
+
+
+TEST_CASE("NodeDataType compares and converts through interned handles", "[interface]")
+{
+  NodeDataType const a{"test-type-a", "A"};
+  NodeDataType const otherA{"test-type-a", "Another name"};
+  NodeDataType const b{"test-type-b", "B"};
+
+  std::size_t const interned = DataTypeRegistry::size();
+
+  NodeDataType const fresh{"test-type-fresh", "Fresh"};
+
+  CHECK(fresh == NodeDataType("test-type-fresh", "Fresh"));
+  CHECK(fresh != a);
+  CHECK(!fresh.hasHandle());
+  CHECK(DataTypeRegistry::size() == interned);
+
+  CHECK(a.handle() == DataTypeRegistry::handle("test-type-a"));
+  CHECK(a == otherA);
+  CHECK(a != b);
+
+  DataModelRegistry registry;
+
+  bool converted = false;
+  registry.registerTypeConverter(std::make_pair(a, b),
+                                 [&converted](std::shared_ptr<NodeData> data)
+  {
+    converted = true;
+    return data;
+  });
+
+  auto converter = registry.getTypeConverter(otherA, b);
+  REQUIRE(converter);
+  converter(nullptr);
+  CHECK(converted);
+
+  CHECK(!registry.getTypeConverter(b, a));
+}
+
+
+TEST_CASE("DataModelRegistry tracks type compatibility", "[interface]")
+{
+  NodeDataType const a{"test-compat-a", "A"};
+  NodeDataType const b{"test-compat-b", "B"};
+  NodeDataType const c{"test-compat-c", "C"};
+
+  DataModelRegistry registry;
+
+  CHECK(registry.compatible(a, a));
+  CHECK(!registry.compatible(a, b));
+
+  registry.registerTypeConverter(std::make_pair(a, b),
+                                 [](std::shared_ptr<NodeData> data)
+  {
+    return data;
+  });
+
+  CHECK(registry.compatible(a, b));
+  CHECK(!registry.compatible(b, a));
+
+  // types interned after the converter was registered are not convertible
+  CHECK(!registry.compatible(a, c));
+  CHECK(!registry.compatible(c.handle(), QtNodes::InvalidTypeHandle));
+}
@@ -0,0 +1,230 @@
+#include <nodes/DiskResultCache>
+#include <nodes/FlowScene>
+#include <nodes/Node>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QTemporaryDir>
+
+#include "ApplicationSetup.hpp"
+#include "StubNodeDataModel.hpp"
+
+using QtNodes::DiskResultCache;
+using QtNodes::FlowScene;
+using QtNodes::NodeData;
+using QtNodes::NodeDataType;
+using QtNodes::PortIndex;
+using QtNodes::PortType;
+
+namespace
+{
+
+class TextData : public NodeData
+{
+public:
+
+  explicit
+  TextData(QString text)
+    : _text(std::move(text))
+  {}
+
+  static NodeDataType staticType()
+  {
+    return NodeDataType {"test-disk-text", "Text"};
+  }
+
+  NodeDataType type() const override
+  { return staticType(); }
+
+  quint64 contentHash() const override
+  { return qHash(_text) + 1; }
+
+  bool serialize(QDataStream & stream) const override
+  {
+    stream << _text;
+    return true;
+  }
+
+  static std::shared_ptr<NodeData> deserialize(QDataStream & stream)
+  {
+    QString text;
+    stream >> text;
+    return std::make_shared<TextData>(text);
+  }
+
+  QString const& text() const
+  { return _text; }
+
+private:
+
+  QString _text;
+};
+
+
+/// Data without a content hash nor a serialized form
+class OpaqueData : public NodeData
+{
+public:
+
+  NodeDataType type() const override
+  {
+    return NodeDataType {"test-disk-opaque", "Opaque"};
+  }
+};
+
+
+/// Derives two outputs from its input, updating and reporting one at a time
+class SplittingModel : public StubNodeDataModel
+{
+public:
+
+  unsigned int nPorts(PortType portType) const override
+  {
+    return (portType == PortType::In) ? 1 : 2;
+  }
+
+  NodeDataType dataType(PortType, PortIndex) const override
+  {
+    return TextData::staticType();
+  }
+
+  std::shared_ptr<NodeData> outData(PortIndex port) override
+  {
+    return _outputs[port];
+  }
+
+  void setInData(std::shared_ptr<NodeData> data, PortIndex) override
+  {
+    auto input = std::dynamic_pointer_cast<TextData>(data);
+
+    for (PortIndex i = 0; i < 2; ++i)
+    {
+      _outputs[i] = input ?
+                    std::make_shared<TextData>(input->text() + QString::number(i)) :
+                    nullptr;
+
+      Q_EMIT dataUpdated(i);
+    }
+  }
+
+private:
+
+  std::shared_ptr<NodeData> _outputs[2];
+};
+
+
+QString
+text(DiskResultCache::Outputs const& outputs, std::size_t index)
+{
+  auto data = std::dynamic_pointer_cast<TextData>(outputs.at(index));
+
+  return data ? data->text() : QString();
+}
+}
+
+
+TEST_CASE("DiskResultCache stores outputs across sessions", "[interface]")
+{
+  QTemporaryDir directory;
+  REQUIRE(directory.isValid());
+
+  auto input = std::make_shared<TextData>("input");
+
+  QByteArray const key = DiskResultCache::makeKey("state", {input, nullptr});
+
+  REQUIRE(!key.isEmpty());
+  CHECK(DiskResultCache::makeKey("state", {input, nullptr}) == key);
+  CHECK(DiskResultCache::makeKey("other state", {input, nullptr}) != key);
+  CHECK(DiskResultCache::makeKey("state", {std::make_shared<OpaqueData>()}).isEmpty());
+
+  {
+    DiskResultCache cache(directory.path());
+
+    CHECK(cache.store(key, {std::make_shared<TextData>("output"), nullptr}));
+    CHECK(!cache.store(key, {std::make_shared<OpaqueData>()}));
+  }
+
+  DiskResultCache cache(directory.path());
+  cache.registerDeserializer(TextData::staticType(), &TextData::deserialize);
+
+  REQUIRE(cache.stats().entries == 1);
+
+  DiskResultCache::Outputs outputs;
+
+  REQUIRE(cache.load(key, outputs));
+  REQUIRE(outputs.size() == 2);
+  CHECK(text(outputs, 0) == "output");
+  CHECK(outputs[1] == nullptr);
+
+  CHECK(!cache.load(DiskResultCache::makeKey("other state", {}), outputs));
+
+  CHECK(cache.stats().hits == 1);
+  CHECK(cache.stats().misses == 1);
+
+  SECTION("verify mode detects differing outputs")
+  {
+    CHECK(cache.verify(key, {std::make_shared<TextData>("output"), nullptr}));
+    CHECK(!cache.verify(key, {std::make_shared<TextData>("changed"), nullptr}));
+
+    CHECK(cache.stats().verified == 2);
+    CHECK(cache.stats().verifyFailures == 1);
+  }
+
+  SECTION("least recently used entries are evicted")
+  {
+    QByteArray const otherKey = DiskResultCache::makeKey("other state", {});
+
+    REQUIRE(cache.store(otherKey, {std::make_shared<TextData>("other")}));
+    REQUIRE(cache.load(key, outputs));
+
+    cache.setMaxSize(cache.stats().diskUsage - 1);
+
+    CHECK(cache.stats().entries == 1);
+    CHECK(cache.stats().evictions == 1);
+    CHECK(cache.load(key, outputs));
+    CHECK(!cache.load(otherKey, outputs));
+
+    cache.clear();
+
+    CHECK(cache.stats().entries == 0);
+    CHECK(QDir(directory.path()).isEmpty());
+  }
+}
+
+
+TEST_CASE("Nodes store the outputs of a computation once", "[interface]")
+{
+  auto setup = applicationSetup();
+
+  QTemporaryDir directory;
+  REQUIRE(directory.isValid());
+
+  auto cache = std::make_shared<DiskResultCache>(directory.path());
+  cache->registerDeserializer(TextData::staticType(), &TextData::deserialize);
+
+  FlowScene scene;
+
+  auto& node = scene.createNode(std::make_unique<SplittingModel>());
+  node.setResultCache(cache);
+
+  node.propagateData(std::make_shared<TextData>("a"), 0);
+
+  // caches are updated from the event loop, once all outputs are reported
+  QCoreApplication::processEvents();
+
+  CHECK(cache->stats().writes == 1);
+  CHECK(cache->stats().entries == 1);
+
+  SECTION("verify mode compares complete outputs")
+  {
+    cache->setVerifyMode(true);
+
+    node.propagateData(std::make_shared<TextData>("a"), 0);
+
+    QCoreApplication::processEvents();
+
+    CHECK(cache->stats().verified == 1);
+    CHECK(cache->stats().verifyFailures == 0);
+  }
+}
@@ -2,6 +2,8 @@
 #include <nodes/FlowScene>
 #include <nodes/FlowView>
 #include <nodes/Node>
+#include <nodes/NodeGroup>
+#include <nodes/internal/GroupGraphicsObject.hpp>
 
 #include <catch2/catch.hpp>
 
@@ -16,6 +18,7 @@ using QtNodes::Connection;
 using QtNodes::DataModelRegistry;
 using QtNodes::FlowScene;
 using QtNodes::FlowView;
+using QtNodes::GroupGraphicsObject;
 using QtNodes::Node;
 using QtNodes::NodeData;
 using QtNodes::NodeDataModel;
@@ -65,4 +68,111 @@ TEST_CASE("Dragging node changes position", "[gui]")
 
     CHECK(roundDelta == roundExpectedDelta);
   }
+
+  SECTION("a group of nodes")
+  {
+    auto& first  = scene.createNode(std::make_unique<StubNodeDataModel>());
+    auto& second = scene.createNode(std::make_unique<StubNodeDataModel>());
+
+    scene.setNodePosition(first, QPointF(0, 0));
+    scene.setNodePosition(second, QPointF(200, 100));
+
+    std::vector<Node*> nodes{&first, &second};
+    auto group = scene.createGroup(nodes).lock();
+    REQUIRE(group);
+
+    GroupGraphicsObject& ggo = group->groupGraphicsObject();
+
+    int movedSignals = 0;
+    int batchSignals = 0;
+    QObject::connect(&scene, &FlowScene::nodeMoved,
+                     [&movedSignals](Node&, QPointF const&) { ++movedSignals; });
+    QObject::connect(&scene, &FlowScene::nodesMoved,
+                     [&batchSignals](std::vector<Node*> const& moved)
+    {
+      ++batchSignals;
+      CHECK(moved.size() == 2);
+    });
+
+    QPointF const firstBefore  = first.nodeGraphicsObject().pos();
+    QPointF const secondBefore = second.nodeGraphicsObject().pos();
+
+    // grab the group by its margin, away from the nodes and the padlock
+    QPointF scClickPos = ggo.mapToScene(ggo.rect().bottomLeft() + QPointF(5, -5));
+    scClickPos         = QPointF(scClickPos.toPoint());
+
+    QPoint vwClickPos = view.mapFromScene(scClickPos);
+    QPoint vwDestPos  = vwClickPos + QPoint(30, 40);
+
+    QPointF scExpectedDelta = view.mapToScene(vwDestPos) - scClickPos;
+
+    QTest::mouseMove(view.windowHandle(), vwClickPos);
+    QTest::mousePress(view.windowHandle(), Qt::LeftButton, Qt::NoModifier, vwClickPos);
+    QTest::mouseMove(view.windowHandle(), vwDestPos);
+    QTest::mouseRelease(view.windowHandle(), Qt::LeftButton, Qt::NoModifier, vwDestPos);
+
+    CHECK((first.nodeGraphicsObject().pos() - firstBefore).toPoint()
+          == scExpectedDelta.toPoint());
+    CHECK((second.nodeGraphicsObject().pos() - secondBefore).toPoint()
+          == scExpectedDelta.toPoint());
+
+    // the nodes are handed back to the scene once the drag is over
+    CHECK(first.nodeGraphicsObject().parentItem() == nullptr);
+    CHECK(second.nodeGraphicsObject().parentItem() == nullptr);
+
+    CHECK(movedSignals == 0);
+    CHECK(batchSignals == 1);
+  }
+
+  SECTION("several selected nodes")
+  {
+    std::vector<Node*> nodes;
+    for (int i = 0; i < 3; ++i)
+    {
+      auto& node = scene.createNode(std::make_unique<StubNodeDataModel>());
+      scene.setNodePosition(node, QPointF(i * 150, 0));
+      node.nodeGraphicsObject().setSelected(true);
+      nodes.push_back(&node);
+    }
+
+    std::vector<QPointF> positionsBefore;
+    for (auto* node : nodes)
+      positionsBefore.push_back(node->nodeGraphicsObject().pos());
+
+    int movedSignals = 0;
+    int batchSignals = 0;
+    QObject::connect(&scene, &FlowScene::nodeMoved,
+                     [&movedSignals](Node&, QPointF const&) { ++movedSignals; });
+    QObject::connect(&scene, &FlowScene::nodesMoved,
+                     [&batchSignals](std::vector<Node*> const& moved)
+    {
+      ++batchSignals;
+      CHECK(moved.size() == 3);
+    });
+
+    auto& ngo = nodes.front()->nodeGraphicsObject();
+
+    QPointF scClickPos = ngo.boundingRect().center();
+    scClickPos         = QPointF(ngo.sceneTransform().map(scClickPos).toPoint());
+
+    QPoint vwClickPos = view.mapFromScene(scClickPos);
+    QPoint vwDestPos  = vwClickPos + QPoint(10, 20);
+
+    QPointF scExpectedDelta = view.mapToScene(vwDestPos) - scClickPos;
+
+    QTest::mouseMove(view.windowHandle(), vwClickPos);
+    QTest::mousePress(view.windowHandle(), Qt::LeftButton, Qt::NoModifier, vwClickPos);
+    QTest::mouseMove(view.windowHandle(), vwDestPos);
+    QTest::mouseRelease(view.windowHandle(), Qt::LeftButton, Qt::NoModifier, vwDestPos);
+
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+      QPointF scDelta = nodes[i]->nodeGraphicsObject().pos() - positionsBefore[i];
+      CHECK(scDelta.toPoint() == scExpectedDelta.toPoint());
+    }
+
+    // the drag is applied in a single batch when the button is released
+    CHECK(movedSignals == 0);
+    CHECK(batchSignals == 1);
+  }
 }
@@ -5,11 +5,17 @@
 #include <utility>
 #include <vector>
 
+#include <nodes/FlowView>
 #include <nodes/Node>
 #include <nodes/NodeDataModel>
 
 #include <catch2/catch.hpp>
 
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtTest>
+
 #include "ApplicationSetup.hpp"
 #include "Stringify.hpp"
 #include "StubNodeDataModel.hpp"
@@ -17,6 +23,7 @@
 using QtNodes::Connection;
 using QtNodes::DataModelRegistry;
 using QtNodes::FlowScene;
+using QtNodes::FlowView;
 using QtNodes::Node;
 using QtNodes::NodeData;
 using QtNodes::NodeDataModel;
@@ -192,6 +199,31 @@ TEST_CASE("FlowScene triggers connections created or deleted", "[gui]")
       }
     }
   }
+
+  SECTION("the scene forwards the events of its connections")
+  {
+    int completed      = 0;
+    int madeIncomplete = 0;
+    int updated        = 0;
+
+    QObject::connect(&scene, &FlowScene::connectionCompleted,
+                     [&completed](Connection const&) { ++completed; });
+    QObject::connect(&scene, &FlowScene::connectionMadeIncomplete,
+                     [&madeIncomplete](Connection const&) { ++madeIncomplete; });
+    QObject::connect(&scene, &FlowScene::connectionUpdated,
+                     [&updated](Connection const&) { ++updated; });
+
+    auto connection = partialCreation.createConnection();
+
+    CHECK(completed == 1);
+    CHECK(updated == 1);
+    CHECK(madeIncomplete == 0);
+
+    scene.deleteConnection(*connection);
+    connection.reset();
+
+    CHECK(madeIncomplete == 1);
+  }
 }
 
 
@@ -254,3 +286,62 @@ TEST_CASE("FlowScene's DataModelRegistry outlives nodes and connections", "[asan
 
   CHECK(modelsDestroyed == 1);
 }
+
+
+TEST_CASE("Virtualized FlowScene parks items outside of the views", "[gui]")
+{
+  auto setup = applicationSetup();
+
+  FlowScene scene;
+  FlowView  view(&scene);
+
+  view.resize(640, 480);
+  view.show();
+  REQUIRE(QTest::qWaitForWindowExposed(&view));
+
+  scene.setVirtualized(true);
+
+  auto& visibleNode = scene.createNode(std::make_unique<StubNodeDataModel>());
+  auto& farNode     = scene.createNode(std::make_unique<StubNodeDataModel>());
+
+  scene.setNodePosition(visibleNode, view.mapToScene(view.viewport()->rect().center()));
+  scene.setNodePosition(farNode, visibleNode.nodeGraphicsObject().pos() + QPointF(1e6, 1e6));
+
+  QCoreApplication::processEvents();
+
+  CHECK(visibleNode.nodeGraphicsObject().scene() == &scene);
+  CHECK(farNode.nodeGraphicsObject().scene() == nullptr);
+
+  SECTION("parked nodes are still saved")
+  {
+    auto const json = QJsonDocument::fromJson(scene.saveToMemory()).object();
+
+    CHECK(json["nodes"].toArray().size() == 2);
+  }
+
+  SECTION("parked nodes are attached when coming into view")
+  {
+    scene.setNodePosition(farNode, visibleNode.nodeGraphicsObject().pos());
+
+    QCoreApplication::processEvents();
+
+    CHECK(farNode.nodeGraphicsObject().scene() == &scene);
+  }
+
+  SECTION("nodes left behind by a pan are parked")
+  {
+    view.centerOn(farNode.nodeGraphicsObject().pos());
+
+    QCoreApplication::processEvents();
+
+    CHECK(visibleNode.nodeGraphicsObject().scene() == nullptr);
+    CHECK(farNode.nodeGraphicsObject().scene() == &scene);
+  }
+
+  SECTION("disabling virtualization attaches everything")
+  {
+    scene.setVirtualized(false);
+
+    CHECK(farNode.nodeGraphicsObject().scene() == &scene);
+  }
+}
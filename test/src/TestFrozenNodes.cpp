@@ -0,0 +1,110 @@
+#include <nodes/Connection>
+#include <nodes/FlowScene>
+#include <nodes/Node>
+#include <nodes/NodeGroup>
+
+#include <catch2/catch.hpp>
+
+#include "ApplicationSetup.hpp"
+#include "DoublingModel.hpp"
+
+using QtNodes::FlowScene;
+using QtNodes::Node;
+
+TEST_CASE("Frozen nodes serve pinned outputs", "[interface]")
+{
+  auto setup = applicationSetup();
+
+  FlowScene scene;
+
+  auto& source = scene.createNode(std::make_unique<DoublingModel>());
+  auto& target = scene.createNode(std::make_unique<DoublingModel>());
+
+  auto connection = scene.createConnection(target, 0, source, 0);
+
+  source.propagateData(std::make_shared<ValueData>(1), 0);
+
+  REQUIRE(outputValue(target) == 4);
+  REQUIRE(computations(target) == 1);
+
+  SECTION("frozen nodes don't compute and keep their outputs")
+  {
+    source.setFrozen(true);
+
+    source.propagateData(std::make_shared<ValueData>(5), 0);
+
+    CHECK(computations(source) == 1);
+    CHECK(outputValue(source) == 2);
+    CHECK(computations(target) == 1);
+
+    source.setFrozen(false);
+
+    CHECK(computations(source) == 2);
+    CHECK(outputValue(source) == 10);
+    CHECK(outputValue(target) == 20);
+  }
+
+  SECTION("data doesn't flow into frozen nodes")
+  {
+    target.setFrozen(true);
+
+    CHECK(connection->connectionGeometry().frozen());
+
+    source.propagateData(std::make_shared<ValueData>(3), 0);
+
+    CHECK(outputValue(source) == 6);
+    CHECK(outputValue(target) == 4);
+    CHECK(computations(target) == 1);
+
+    CHECK(target.save()["frozen"].toBool());
+
+    target.setFrozen(false);
+
+    CHECK(!connection->connectionGeometry().frozen());
+    CHECK(outputValue(target) == 12);
+    CHECK(!target.save().contains("frozen"));
+  }
+
+  SECTION("inputs are only held while the node is frozen")
+  {
+    auto data = std::make_shared<ValueData>(7);
+    std::weak_ptr<ValueData> input = data;
+
+    target.propagateData(std::move(data), 0);
+
+    CHECK(outputValue(target) == 14);
+    CHECK(input.expired());
+
+    target.setFrozen(true);
+
+    data  = std::make_shared<ValueData>(8);
+    input = data;
+
+    target.propagateData(std::move(data), 0);
+
+    CHECK(!input.expired());
+
+    target.setFrozen(false);
+
+    CHECK(outputValue(target) == 16);
+    CHECK(input.expired());
+  }
+
+  SECTION("groups freeze all their nodes")
+  {
+    std::vector<Node*> nodes{&source, &target};
+
+    auto group = scene.createGroup(nodes).lock();
+    REQUIRE(group);
+
+    group->setFrozen(true);
+
+    CHECK(source.isFrozen());
+    CHECK(target.isFrozen());
+    CHECK(group->isFrozen());
+
+    target.setFrozen(false);
+
+    CHECK(!group->isFrozen());
+  }
+}
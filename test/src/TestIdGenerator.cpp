@@ -0,0 +1,59 @@
+#include <nodes/IdGenerator>
+#include <nodes/Node>
+
+#include <catch2/catch.hpp>
+
+#include <unordered_set>
+
+#include "ApplicationSetup.hpp"
+#include "StubNodeDataModel.hpp"
+
+using QtNodes::IdGenerator;
+using QtNodes::Node;
+using QtNodes::ObjectId;
+
+TEST_CASE("IdGenerator hands out monotonic ids and distinct UUIDs", "[interface]")
+{
+  ObjectId const first  = IdGenerator::next();
+  ObjectId const second = IdGenerator::next();
+
+  CHECK(first != 0);
+  CHECK(second > first);
+
+  std::unordered_set<QUuid> uuids;
+  for (ObjectId id = first; id < first + 1000; ++id)
+  {
+    QUuid const uuid = IdGenerator::uuid(id);
+
+    CHECK(uuid.version() == QUuid::Random);
+    CHECK(uuid.variant() == QUuid::DCE);
+    CHECK(IdGenerator::uuid(id) == uuid);
+    CHECK(IdGenerator::objectId(uuid) == id);
+
+    uuids.insert(uuid);
+  }
+  CHECK(uuids.size() == 1000);
+
+  // UUIDs from elsewhere don't map back to an id
+  CHECK(IdGenerator::objectId(QUuid::createUuid()) == 0);
+  CHECK(IdGenerator::objectId(QUuid()) == 0);
+}
+
+TEST_CASE("Node UUIDs are derived lazily and can be restored", "[interface]")
+{
+  auto setup = applicationSetup();
+
+  // kept out of any scene, which would have to be told about the restored UUID
+  Node node(std::make_unique<StubNodeDataModel>());
+
+  CHECK(node.id() == IdGenerator::uuid(node.objectId()));
+  CHECK(node.id() == node.id());
+
+  QUuid const stored = QUuid::createUuid();
+
+  QJsonObject json;
+  json["id"] = stored.toString();
+
+  node.retrieveID(json);
+  CHECK(node.id() == stored);
+}
@@ -0,0 +1,118 @@
+#include <nodes/DataModelRegistry>
+#include <nodes/internal/ModelPaletteIndex.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QElapsedTimer>
+
+#include <iostream>
+
+#include "StubNodeDataModel.hpp"
+
+using QtNodes::DataModelRegistry;
+using QtNodes::ModelDescriptor;
+using QtNodes::ModelPaletteIndex;
+
+namespace
+{
+
+void
+registerModel(DataModelRegistry& registry, QString name, QString category)
+{
+  ModelDescriptor descriptor;
+  descriptor.name     = std::move(name);
+  descriptor.category = std::move(category);
+
+  registry.registerModel(std::move(descriptor), [] {
+    return std::make_unique<StubNodeDataModel>();
+  });
+}
+
+
+QStringList
+matchedNames(ModelPaletteIndex const& index, QString const& filter)
+{
+  QStringList names;
+
+  for (auto i : index.match(filter))
+    names << index.entries()[i].name;
+
+  return names;
+}
+}
+
+
+TEST_CASE("ModelPaletteIndex filters model names", "[interface]")
+{
+  DataModelRegistry registry;
+
+  registerModel(registry, "Subtraction", "Math");
+  registerModel(registry, "Addition", "Math");
+  registerModel(registry, "Image Loader", "Images");
+
+  ModelPaletteIndex index;
+  index.update(registry);
+
+  REQUIRE(index.entries().size() == 3);
+  CHECK(index.entries()[0].name == "Addition");
+  CHECK(index.entries()[1].category == "Images");
+
+  CHECK(matchedNames(index, "") ==
+        QStringList({"Addition", "Image Loader", "Subtraction"}));
+  CHECK(matchedNames(index, "a") ==
+        QStringList({"Addition", "Image Loader", "Subtraction"}));
+  CHECK(matchedNames(index, "TI") == QStringList({"Addition", "Subtraction"}));
+  CHECK(matchedNames(index, "ion") == QStringList({"Addition", "Subtraction"}));
+  CHECK(matchedNames(index, "e lo") == QStringList({"Image Loader"}));
+  CHECK(matchedNames(index, "traction") == QStringList({"Subtraction"}));
+  CHECK(matchedNames(index, "tioni").isEmpty());
+  CHECK(matchedNames(index, "xyz").isEmpty());
+
+  SECTION("the index follows the registry")
+  {
+    registerModel(registry, "Division", "Math");
+
+    index.update(registry);
+
+    CHECK(matchedNames(index, "ion") ==
+          QStringList({"Addition", "Division", "Subtraction"}));
+  }
+}
+
+
+TEST_CASE("Filtering a large model palette", "[.][benchmark]")
+{
+  int const modelCount = 2000;
+
+  DataModelRegistry registry;
+
+  for (int i = 0; i < modelCount; ++i)
+  {
+    registerModel(registry,
+                  QStringLiteral("Model %1 %2").arg(i).arg(i % 7 ? "Filter" : "Source"),
+                  QStringLiteral("Category %1").arg(i % 20));
+  }
+
+  ModelPaletteIndex index;
+
+  QElapsedTimer timer;
+  timer.start();
+
+  index.update(registry);
+
+  std::cout << "index " << modelCount << " models: "
+            << timer.nsecsElapsed() / 1000 << " us\n";
+
+  for (QString const filter : {"s", "so", "sou", "source", "model 19"})
+  {
+    timer.restart();
+
+    auto const matches = index.match(filter);
+
+    std::cout << "match \"" << filter.toStdString() << "\": "
+              << matches.size() << " models in "
+              << timer.nsecsElapsed() / 1000 << " us\n";
+  }
+
+  CHECK(index.match("source").size() == std::size_t((modelCount + 6) / 7));
+}
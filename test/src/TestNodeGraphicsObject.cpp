@@ -64,3 +64,276 @@ TEST_CASE("NodeDataModel::portOutConnectionPolicy(...) isn't called for input "
 
   CHECK(model.portOutConnectionPolicyCalledCount == 0);
 }
+
+
+TEST_CASE("NodeGeometry reuses its text layout until the model changes",
+          "[gui]")
+{
+  class MockModel : public StubNodeDataModel
+  {
+  public:
+    QString
+    caption() const override
+    {
+      captionCalledCount++;
+      return StubNodeDataModel::caption();
+    }
+
+    mutable int captionCalledCount = 0;
+  };
+
+  auto setup = applicationSetup();
+
+  FlowScene scene;
+
+  auto& node  = scene.createNode(std::make_unique<MockModel>());
+  auto& model = dynamic_cast<MockModel&>(*node.nodeDataModel());
+  auto& ngeom = node.nodeGeometry();
+
+  QFont font = ngeom.font();
+
+  ngeom.recalculateSize(font);
+
+  int const calls = model.captionCalledCount;
+
+  SECTION("unchanged node")
+  {
+    ngeom.recalculateSize(font);
+    ngeom.recalculateSize(font);
+
+    CHECK(model.captionCalledCount == calls);
+  }
+
+  SECTION("model revision changed")
+  {
+    model.invalidateLayout();
+    ngeom.recalculateSize(font);
+
+    CHECK(model.captionCalledCount == calls + 1);
+  }
+
+  SECTION("font changed")
+  {
+    font.setPointSize(font.pointSize() + 4);
+    ngeom.recalculateSize(font);
+
+    CHECK(model.captionCalledCount == calls + 1);
+  }
+}
+
+
+TEST_CASE("Deferred embedded widgets are created on demand", "[gui]")
+{
+  class MockModel : public StubNodeDataModel
+  {
+  public:
+    QWidget*
+    embeddedWidget() override
+    {
+      if (!widget)
+      {
+        widget = new QWidget();
+        widget->resize(120, 80);
+      }
+
+      return widget;
+    }
+
+    bool
+    embeddedWidgetDeferred() const override
+    {
+      return true;
+    }
+
+    QSize
+    embeddedWidgetSizeHint() const override
+    {
+      return QSize(120, 80);
+    }
+
+    QWidget* widget = nullptr;
+  };
+
+  auto setup = applicationSetup();
+
+  FlowScene scene;
+
+  auto& node  = scene.createNode(std::make_unique<MockModel>());
+  auto& model = dynamic_cast<MockModel&>(*node.nodeDataModel());
+  auto& ngeom = node.nodeGeometry();
+
+  CHECK(model.widget == nullptr);
+
+  // the node is laid out from the size hint in the meantime
+  CHECK(ngeom.height() >= 80u);
+  CHECK(ngeom.width() >= 120u);
+
+  node.nodeGraphicsObject().createDeferredWidget();
+
+  CHECK(model.widget != nullptr);
+  CHECK(model.createdEmbeddedWidget() == model.widget);
+}
+
+
+TEST_CASE("Deferred embedded widgets are requested once the node is in view",
+          "[gui]")
+{
+  class MockModel : public StubNodeDataModel
+  {
+  public:
+    QWidget*
+    embeddedWidget() override
+    {
+      embeddedWidgetCalledCount++;
+      return nullptr;
+    }
+
+    bool
+    embeddedWidgetDeferred() const override
+    {
+      return true;
+    }
+
+    QSize
+    embeddedWidgetSizeHint() const override
+    {
+      return QSize(120, 80);
+    }
+
+    int embeddedWidgetCalledCount = 0;
+  };
+
+  auto setup = applicationSetup();
+
+  FlowScene scene;
+  FlowView  view(&scene);
+
+  view.resize(640, 480);
+  view.show();
+  REQUIRE(QTest::qWaitForWindowExposed(&view));
+
+  auto& node  = scene.createNode(std::make_unique<MockModel>());
+  auto& model = dynamic_cast<MockModel&>(*node.nodeDataModel());
+  auto& ngo   = node.nodeGraphicsObject();
+
+  ngo.setPos(view.mapToScene(view.viewport()->rect().center()));
+
+  REQUIRE(QTest::qWaitFor([&] { return model.embeddedWidgetCalledCount > 0; }));
+
+  // a model without a widget isn't asked again, however often it's painted
+  for (int i = 0; i < 5; ++i)
+  {
+    view.viewport()->repaint();
+    QCoreApplication::processEvents();
+  }
+
+  ngo.createDeferredWidget();
+
+  CHECK(model.embeddedWidgetCalledCount == 1);
+  CHECK(model.createdEmbeddedWidget() == nullptr);
+  CHECK(model.embeddedWidgetSize().isEmpty());
+}
+
+TEST_CASE("Embedded widgets are swapped for snapshots taken outside of painting",
+          "[gui]")
+{
+  class PaintCountingWidget : public QWidget
+  {
+  public:
+    int paintCount = 0;
+
+  protected:
+    void
+    paintEvent(QPaintEvent*) override
+    {
+      paintCount++;
+    }
+  };
+
+  class MockModel : public StubNodeDataModel
+  {
+  public:
+    MockModel()
+    {
+      widget->resize(120, 80);
+    }
+
+    QWidget*
+    embeddedWidget() override
+    {
+      return widget;
+    }
+
+    // owned by the node's proxy widget
+    PaintCountingWidget* widget = new PaintCountingWidget();
+  };
+
+  auto setup = applicationSetup();
+
+  FlowScene scene;
+  FlowView  view(&scene);
+
+  view.resize(640, 480);
+  view.show();
+  REQUIRE(QTest::qWaitForWindowExposed(&view));
+
+  scene.setWidgetSnapshotsEnabled(true);
+
+  auto& node  = scene.createNode(std::make_unique<MockModel>());
+  auto& model = dynamic_cast<MockModel&>(*node.nodeDataModel());
+  auto& ngo   = node.nodeGraphicsObject();
+
+  ngo.setPos(view.mapToScene(view.viewport()->rect().center()));
+
+  CHECK_FALSE(ngo.isWidgetLive());
+  CHECK_FALSE(model.widget->isVisible());
+
+  // painting the node doesn't grab the widget, the snapshot timer does
+  view.viewport()->repaint();
+  CHECK(model.widget->paintCount == 0);
+
+  REQUIRE(QTest::qWaitFor([&] { return model.widget->paintCount == 1; }));
+
+  SECTION("changes are coalesced into a single snapshot")
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      model.invalidateLayout();
+      ngo.scheduleWidgetSnapshot();
+      view.viewport()->repaint();
+    }
+
+    CHECK(model.widget->paintCount == 1);
+
+    QTest::qWait(500);
+
+    CHECK(model.widget->paintCount == 2);
+  }
+
+  SECTION("setWidgetLive() swaps the live widget in and out")
+  {
+    ngo.setWidgetLive(true);
+
+    CHECK(ngo.isWidgetLive());
+    CHECK(model.widget->isVisible());
+
+    ngo.setWidgetLive(false);
+
+    CHECK_FALSE(ngo.isWidgetLive());
+    CHECK_FALSE(model.widget->isVisible());
+  }
+
+  SECTION("hovering swaps the live widget in until the user leaves it")
+  {
+    QPoint const nodeCenter =
+      view.mapFromScene(ngo.mapToScene(node.nodeGeometry().boundingRect().center()));
+
+    QTest::mouseMove(view.viewport(), nodeCenter);
+
+    REQUIRE(QTest::qWaitFor([&] { return ngo.isWidgetLive(); }));
+
+    QTest::mouseMove(view.viewport(), QPoint(1, 1));
+
+    CHECK(QTest::qWaitFor([&] { return !ngo.isWidgetLive(); }, 5000));
+  }
+}
@@ -5,6 +5,7 @@
 #include <nodes/FlowScene>
 #include <nodes/FlowView>
 #include <nodes/Node>
+#include <nodes/internal/GroupGraphicsObject.hpp>
 
 #include "ApplicationSetup.hpp"
 #include "StubNodeDataModel.hpp"
@@ -13,6 +14,7 @@ using QtNodes::FlowView;
 using QtNodes::FlowScene;
 using QtNodes::Node;
 using QtNodes::DataModelRegistry;
+using QtNodes::GroupGraphicsObject;
 
 constexpr size_t nodesPerGroup = 5;
 constexpr size_t nGroups = 2;
@@ -443,3 +445,69 @@ TEST_CASE("Saving and loading groups", "[node groups][namo]")
     }
   }
 }
+
+
+TEST_CASE("Group bounds follow their nodes", "[node groups]")
+{
+  auto setup = applicationSetup();
+
+  FlowScene scene;
+
+  auto& left  = scene.createNode(std::make_unique<MockModel>());
+  auto& right = scene.createNode(std::make_unique<MockModel>());
+  auto& extra = scene.createNode(std::make_unique<MockModel>());
+
+  scene.setNodePosition(left, QPointF(0, 0));
+  scene.setNodePosition(right, QPointF(400, 0));
+  scene.setNodePosition(extra, QPointF(1000, 1000));
+
+  std::vector<Node*> nodes{&left, &right};
+  auto group = scene.createGroup(nodes).lock();
+  REQUIRE(group);
+
+  GroupGraphicsObject& ggo = group->groupGraphicsObject();
+
+  auto sceneBounds = [&ggo]
+  {
+    return ggo.mapRectToScene(ggo.boundingRect());
+  };
+
+  auto nodeRect = [](Node& node)
+  {
+    return node.nodeGraphicsObject().sceneBoundingRect();
+  };
+
+  QRectF const initial = sceneBounds();
+  CHECK(initial.contains(nodeRect(left)));
+  CHECK(initial.contains(nodeRect(right)));
+  CHECK(ggo.mapRectToScene(ggo.rect()) == initial);
+
+  SECTION("Moving a node outwards grows the group")
+  {
+    scene.setNodePosition(right, QPointF(800, 0));
+    CHECK(sceneBounds().contains(nodeRect(right)));
+    CHECK(sceneBounds().width() > initial.width());
+
+    SECTION("and moving it back shrinks it again")
+    {
+      scene.setNodePosition(right, QPointF(400, 0));
+      CHECK(sceneBounds() == initial);
+    }
+  }
+
+  SECTION("Moving a node inside the group keeps its bounds")
+  {
+    scene.setNodePosition(left, QPointF(10, 0));
+    CHECK(sceneBounds().contains(nodeRect(left)));
+    CHECK(sceneBounds().right() == initial.right());
+  }
+
+  SECTION("Nodes joining and leaving the group update its bounds")
+  {
+    scene.addNodeToGroup(extra.id(), group->id());
+    CHECK(sceneBounds().contains(nodeRect(extra)));
+
+    scene.removeNodeFromGroup(extra.id());
+    CHECK(sceneBounds() == initial);
+  }
+}
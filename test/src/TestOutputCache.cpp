@@ -0,0 +1,106 @@
+#include <nodes/FlowScene>
+#include <nodes/Node>
+#include <nodes/OutputCache>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QCoreApplication>
+
+#include "ApplicationSetup.hpp"
+#include "DoublingModel.hpp"
+
+using QtNodes::FlowScene;
+using QtNodes::Node;
+using QtNodes::OutputCache;
+
+TEST_CASE("Nodes reuse cached outputs", "[interface]")
+{
+  auto setup = applicationSetup();
+
+  FlowScene scene;
+
+  auto& node = scene.createNode(std::make_unique<DoublingModel>());
+  auto* model = static_cast<DoublingModel*>(node.nodeDataModel());
+
+  auto cache = std::make_shared<OutputCache>();
+  node.setOutputCache(cache);
+
+  // caches are updated from the event loop, once per computation
+  node.propagateData(std::make_shared<ValueData>(1), 0);
+  QCoreApplication::processEvents();
+
+  node.propagateData(std::make_shared<ValueData>(2), 0);
+  QCoreApplication::processEvents();
+
+  CHECK(model->computations == 2);
+  CHECK(outputValue(node) == 4);
+
+  SECTION("equal inputs are served from the cache")
+  {
+    node.propagateData(std::make_shared<ValueData>(1), 0);
+
+    CHECK(model->computations == 2);
+    CHECK(outputValue(node) == 2);
+    CHECK(cache->stats().hits == 1);
+
+    // new inputs go to the model again, which takes over from the cache
+    node.propagateData(std::make_shared<ValueData>(3), 0);
+
+    CHECK(model->computations == 3);
+    CHECK(outputValue(node) == 6);
+  }
+
+  SECTION("nodes without a cache always compute")
+  {
+    node.setOutputCache(nullptr);
+
+    node.propagateData(std::make_shared<ValueData>(1), 0);
+
+    CHECK(model->computations == 3);
+    CHECK(cache->stats().entries == 0);
+  }
+}
+
+
+TEST_CASE("OutputCache evicts least recently used entries", "[interface]")
+{
+  OutputCache cache;
+
+  auto keyOf = [](int value)
+  {
+    return OutputCache::makeKey(1, QByteArray(), {std::make_shared<ValueData>(value)});
+  };
+
+  auto insert = [&](int value)
+  {
+    cache.insert(keyOf(value), {std::make_shared<ValueData>(value)}, {});
+  };
+
+  insert(1);
+
+  std::size_t const entrySize = cache.stats().memoryUsage;
+
+  insert(2);
+  insert(3);
+
+  REQUIRE(cache.stats().entries == 3);
+
+  // touching 1 makes 2 the least recently used entry
+  CHECK(cache.find(keyOf(1)) != nullptr);
+
+  cache.setMemoryBudget(2 * entrySize);
+
+  CHECK(cache.stats().entries == 2);
+  CHECK(cache.stats().evictions == 1);
+  CHECK(cache.find(keyOf(2)) == nullptr);
+  CHECK(cache.find(keyOf(1)) != nullptr);
+  CHECK(cache.find(keyOf(3)) != nullptr);
+
+  CHECK(cache.stats().hits == 3);
+  CHECK(cache.stats().misses == 1);
+
+  cache.remove(1);
+
+  CHECK(cache.stats().entries == 0);
+  CHECK(cache.stats().memoryUsage == 0);
+}
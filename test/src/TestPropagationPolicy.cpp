@@ -0,0 +1,95 @@
+#include <nodes/Connection>
+#include <nodes/FlowScene>
+#include <nodes/Node>
+#include <nodes/PropagationPolicy>
+
+#include <catch2/catch.hpp>
+
+#include <QtTest/QTest>
+
+#include "ApplicationSetup.hpp"
+#include "DoublingModel.hpp"
+
+using QtNodes::FlowScene;
+using QtNodes::Node;
+using QtNodes::PropagationPolicy;
+
+TEST_CASE("Connections propagate as their policy allows", "[interface]")
+{
+  auto setup = applicationSetup();
+
+  FlowScene scene;
+
+  auto& source = scene.createNode(std::make_unique<DoublingModel>());
+  auto& target = scene.createNode(std::make_unique<DoublingModel>());
+
+  auto connection = scene.createConnection(target, 0, source, 0);
+
+  int const samples = 100;
+
+  SECTION("immediate connections deliver every value")
+  {
+    connection->resetPropagationStats();
+
+    for (int i = 1; i <= samples; ++i)
+      source.propagateData(std::make_shared<ValueData>(i), 0);
+
+    CHECK(connection->propagationStats().received == samples);
+    CHECK(connection->propagationStats().delivered == samples);
+    CHECK(connection->propagationStats().dropped == 0);
+    CHECK(outputValue(target) == 4 * samples);
+  }
+
+  SECTION("latest value connections coalesce values")
+  {
+    connection->setPropagationPolicy(PropagationPolicy::latestValue(50.0));
+
+    // let the delivery made on connection be due again
+    QTest::qWait(30);
+
+    connection->resetPropagationStats();
+    int const computed = computations(target);
+
+    for (int i = 1; i <= samples; ++i)
+      source.propagateData(std::make_shared<ValueData>(i), 0);
+
+    // the first value goes through, the others wait for the next tick
+    CHECK(connection->propagationStats().delivered == 1);
+    CHECK(outputValue(target) == 4);
+
+    QTest::qWait(100);
+
+    CHECK(connection->propagationStats().received == samples);
+    CHECK(connection->propagationStats().delivered == 2);
+    CHECK(connection->propagationStats().dropped == samples - 2);
+    CHECK(computations(target) == computed + 2);
+    CHECK(outputValue(target) == 4 * samples);
+  }
+
+  SECTION("resetting the input drops the value held back")
+  {
+    connection->setPropagationPolicy(PropagationPolicy::latestValue(50.0));
+
+    QTest::qWait(30);
+
+    connection->resetPropagationStats();
+
+    source.propagateData(std::make_shared<ValueData>(1), 0);
+    source.propagateData(std::make_shared<ValueData>(2), 0);
+
+    REQUIRE(connection->propagationStats().delivered == 1);
+    REQUIRE(connection->propagationStats().dropped == 0);
+
+    connection->propagateEmptyData();
+
+    CHECK(connection->propagationStats().dropped == 1);
+    CHECK(connection->propagationStats().delivered == 2);
+    CHECK(outputValue(target) == -1);
+
+    // nothing is left to deliver on the next tick
+    QTest::qWait(100);
+
+    CHECK(connection->propagationStats().delivered == 2);
+    CHECK(outputValue(target) == -1);
+  }
+}
@@ -0,0 +1,119 @@
+#include <nodes/FlowScene>
+#include <nodes/Node>
+#include <nodes/SceneChanges>
+
+#include <catch2/catch.hpp>
+
+#include "ApplicationSetup.hpp"
+#include "StubNodeDataModel.hpp"
+
+using QtNodes::FlowScene;
+using QtNodes::Node;
+using QtNodes::SceneChangeAccumulator;
+using QtNodes::SceneChanges;
+
+TEST_CASE("SceneChangeAccumulator collapses repeated changes", "[interface]")
+{
+  SceneChangeAccumulator accumulator;
+
+  QUuid const a = QUuid::createUuid();
+  QUuid const b = QUuid::createUuid();
+  QUuid const c = QUuid::createUuid();
+
+  CHECK(accumulator.empty());
+
+  SECTION("moves keep the last position of each node")
+  {
+    accumulator.nodeMoved(a, QPointF(1, 1));
+    accumulator.nodeMoved(b, QPointF(2, 2));
+    accumulator.nodeMoved(a, QPointF(3, 3));
+
+    SceneChanges changes = accumulator.take();
+
+    REQUIRE(changes.movedNodes.size() == 2);
+    CHECK(changes.movedNodes[0] == a);
+    CHECK(changes.movedNodePositions[0] == QPointF(3, 3));
+    CHECK(changes.movedNodes[1] == b);
+    CHECK(changes.movedNodePositions[1] == QPointF(2, 2));
+
+    CHECK(accumulator.empty());
+  }
+
+  SECTION("nodes created and deleted within a frame are dropped")
+  {
+    accumulator.nodeCreated(a);
+    accumulator.nodeMoved(a, QPointF(1, 1));
+    accumulator.nodeUpdated(a);
+    accumulator.nodeMoved(b, QPointF(2, 2));
+    accumulator.nodeDeleted(a);
+    accumulator.nodeDeleted(c);
+
+    SceneChanges changes = accumulator.take();
+
+    CHECK(changes.createdNodes.empty());
+    CHECK(changes.updatedNodes.empty());
+    REQUIRE(changes.movedNodes.size() == 1);
+    CHECK(changes.movedNodes[0] == b);
+    CHECK(changes.movedNodePositions[0] == QPointF(2, 2));
+    REQUIRE(changes.deletedNodes.size() == 1);
+    CHECK(changes.deletedNodes[0] == c);
+  }
+
+  SECTION("connections created and deleted within a frame are dropped")
+  {
+    accumulator.connectionCreated(a);
+    accumulator.connectionCreated(b);
+    accumulator.connectionDeleted(a);
+    accumulator.connectionDeleted(c);
+
+    SceneChanges changes = accumulator.take();
+
+    REQUIRE(changes.createdConnections.size() == 1);
+    CHECK(changes.createdConnections[0] == b);
+    REQUIRE(changes.deletedConnections.size() == 1);
+    CHECK(changes.deletedConnections[0] == c);
+  }
+}
+
+TEST_CASE("FlowScene commits its changes in batches", "[interface]")
+{
+  auto setup = applicationSetup();
+
+  FlowScene scene;
+
+  std::vector<SceneChanges> committed;
+  QObject::connect(&scene, &FlowScene::changesCommitted,
+                   [&committed](SceneChanges const& changes)
+  {
+    committed.push_back(changes);
+  });
+
+  int movedSignals = 0;
+  QObject::connect(&scene, &FlowScene::nodeMoved,
+                   [&movedSignals](Node&, QPointF const&) { ++movedSignals; });
+
+  auto& node = scene.createNode(std::make_unique<StubNodeDataModel>());
+  scene.setNodePosition(node, QPointF(10, 20));
+  scene.setNodePosition(node, QPointF(30, 40));
+
+  CHECK(committed.empty());
+
+  scene.flushChanges();
+
+  REQUIRE(committed.size() == 1);
+  CHECK(committed[0].createdNodes == std::vector<QUuid>{node.id()});
+  CHECK(committed[0].movedNodes == std::vector<QUuid>{node.id()});
+  CHECK(committed[0].movedNodePositions == std::vector<QPointF>{QPointF(30, 40)});
+
+  // fine-grained move signals are opt-in
+  CHECK(movedSignals == 0);
+
+  scene.setNodeMovedSignalsEnabled(true);
+  scene.setNodePosition(node, QPointF(50, 60));
+  CHECK(movedSignals == 1);
+
+  scene.flushChanges();
+  REQUIRE(committed.size() == 2);
+  CHECK(committed[1].createdNodes.empty());
+  CHECK(committed[1].movedNodePositions == std::vector<QPointF>{QPointF(50, 60)});
+}
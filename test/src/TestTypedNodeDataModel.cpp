@@ -0,0 +1,234 @@
+#include <nodes/TypedNodeDataModel>
+
+#include <catch2/catch.hpp>
+
+#include <QtCore/QElapsedTimer>
+
+#include <iostream>
+
+using QtNodes::InPort;
+using QtNodes::Inputs;
+using QtNodes::NodeData;
+using QtNodes::NodeDataModel;
+using QtNodes::NodeDataType;
+using QtNodes::OutPort;
+using QtNodes::Outputs;
+using QtNodes::PortIndex;
+using QtNodes::PortType;
+using QtNodes::TypedNodeDataModel;
+using QtNodes::TypeHandle;
+
+namespace
+{
+
+class NumberData : public NodeData
+{
+public:
+
+  explicit
+  NumberData(double value = 0.0)
+    : _value(value)
+  {}
+
+  static NodeDataType staticType()
+  {
+    return NodeDataType {"test-typed-number", "Number"};
+  }
+
+  NodeDataType type() const override
+  { return staticType(); }
+
+  TypeHandle typeHandle() const override
+  { return QtNodes::staticTypeHandle<NumberData>(); }
+
+  double value() const
+  { return _value; }
+
+private:
+
+  double _value;
+};
+
+
+class TextData : public NodeData
+{
+public:
+
+  static NodeDataType staticType()
+  {
+    return NodeDataType {"test-typed-text", "Text"};
+  }
+
+  NodeDataType type() const override
+  { return staticType(); }
+};
+
+
+/// Common part of the models below, which only differ in how ports are typed
+template <typename Base>
+class SumModelBase : public Base
+{
+public:
+
+  QString caption() const override { return QStringLiteral("Sum"); }
+
+  QString progressValue() const override { return QString(); }
+
+  QString name() const override { return QStringLiteral("Sum"); }
+
+  QString nickname() const override { return QString(); }
+
+  QWidget* embeddedWidget() override { return nullptr; }
+
+protected:
+
+  void
+  compute()
+  {
+    if (_a && _b)
+      _result = std::make_shared<NumberData>(_a->value() + _b->value());
+    else
+      _result.reset();
+  }
+
+protected:
+
+  std::shared_ptr<NumberData> _a;
+  std::shared_ptr<NumberData> _b;
+  std::shared_ptr<NumberData> _result;
+};
+
+
+class TypedSumModel
+  : public SumModelBase<TypedNodeDataModel<Inputs<NumberData, NumberData>,
+                                           Outputs<NumberData>>>
+{
+public:
+
+  void
+  setTypedInData(std::shared_ptr<NumberData> data, InPort<0>) override
+  {
+    _a = std::move(data);
+    compute();
+  }
+
+  void
+  setTypedInData(std::shared_ptr<NumberData> data, InPort<1>) override
+  {
+    _b = std::move(data);
+    compute();
+  }
+
+  std::shared_ptr<NumberData>
+  typedOutData(OutPort<0>) override
+  {
+    return _result;
+  }
+};
+
+
+class VirtualSumModel : public SumModelBase<NodeDataModel>
+{
+public:
+
+  unsigned int
+  nPorts(PortType portType) const override
+  {
+    return (portType == PortType::In) ? 2 : 1;
+  }
+
+  NodeDataType
+  dataType(PortType, PortIndex) const override
+  {
+    return NumberData::staticType();
+  }
+
+  void
+  setInData(std::shared_ptr<NodeData> data, PortIndex port) override
+  {
+    auto number = std::dynamic_pointer_cast<NumberData>(data);
+
+    if (port == 0)
+      _a = std::move(number);
+    else
+      _b = std::move(number);
+
+    compute();
+  }
+
+  std::shared_ptr<NodeData>
+  outData(PortIndex) override
+  {
+    return _result;
+  }
+};
+}
+
+
+TEST_CASE("TypedNodeDataModel generates its ports", "[interface]")
+{
+  TypedSumModel typedModel;
+
+  // the typed overloads hide the generic entry points used by the scene
+  NodeDataModel& model = typedModel;
+
+  CHECK(model.nPorts(PortType::In) == 2);
+  CHECK(model.nPorts(PortType::Out) == 1);
+  CHECK(model.nPorts(PortType::None) == 0);
+
+  CHECK(model.dataType(PortType::In, 1) == NumberData::staticType());
+  CHECK(model.dataType(PortType::Out, 0) == NumberData::staticType());
+  CHECK(model.dataType(PortType::Out, 1).id.isEmpty());
+  CHECK(model.portCaption(PortType::In, 0) == "Number");
+
+  SECTION("data of the port type is delivered")
+  {
+    model.setInData(std::make_shared<NumberData>(1.0), 0);
+    model.setInData(std::make_shared<NumberData>(2.0), 1);
+
+    auto result = std::dynamic_pointer_cast<NumberData>(model.outData(0));
+    REQUIRE(result);
+    CHECK(result->value() == 3.0);
+    CHECK(!model.outData(1));
+  }
+
+  SECTION("data of another type is delivered as nullptr")
+  {
+    model.setInData(std::make_shared<NumberData>(1.0), 0);
+    model.setInData(std::make_shared<TextData>(), 1);
+
+    CHECK(!model.outData(0));
+  }
+}
+
+
+TEST_CASE("Typed and virtual input dispatch", "[.][benchmark]")
+{
+  int const iterations = 1000000;
+
+  auto const a = std::make_shared<NumberData>(1.0);
+  auto const b = std::make_shared<NumberData>(2.0);
+
+  auto run = [&](char const* label, NodeDataModel& model)
+  {
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < iterations; ++i)
+    {
+      model.setInData(a, 0);
+      model.setInData(b, 1);
+    }
+
+    std::cout << label << ": "
+              << timer.nsecsElapsed() / (2 * iterations) << " ns/input\n";
+
+    CHECK(model.outData(0));
+  };
+
+  VirtualSumModel virtualModel;
+  TypedSumModel typedModel;
+
+  run("dynamic_pointer_cast", virtualModel);
+  run("TypedNodeDataModel", typedModel);
+}